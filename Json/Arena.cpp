@@ -0,0 +1,95 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Arena.h"
+#include <cstdlib>
+
+namespace Rt2::Json
+{
+    Arena::Arena() :
+        _blocks(nullptr),
+        _cur(nullptr),
+        _end(nullptr),
+        _head(nullptr),
+        _tail(nullptr),
+        _used(0)
+    {
+    }
+
+    Arena::~Arena()
+    {
+        clear();
+    }
+
+    void* Arena::grow(const size_t size, const size_t align)
+    {
+        // oversized requests get a block of their own
+        const size_t need  = sizeof(Block) + (align - 1) + size;
+        const size_t total = need > BlockSize ? need : BlockSize;
+
+        Block* block = (Block*)std::malloc(total);
+        if (!block)
+            throw std::bad_alloc();
+
+        block->next = _blocks;
+        block->size = total;
+        _blocks     = block;
+
+        char* ptr = (char*)(((size_t)(block + 1) + (align - 1)) & ~(align - 1));
+        _cur      = ptr + size;
+        _end      = (char*)block + total;
+        _used += size;
+        return ptr;
+    }
+
+    void Arena::finalize(void* object, void (*destroy)(void*))
+    {
+        Finalizer* fin = (Finalizer*)allocate(sizeof(Finalizer), alignof(Finalizer));
+        fin->next      = nullptr;
+        fin->object    = object;
+        fin->destroy   = destroy;
+
+        if (_tail)
+            _tail->next = fin;
+        else
+            _head = fin;
+        _tail = fin;
+    }
+
+    void Arena::clear()
+    {
+        // finalizers live in the blocks, so they run before any block is freed
+        for (const Finalizer* fin = _head; fin; fin = fin->next)
+            fin->destroy(fin->object);
+        _head = _tail = nullptr;
+
+        while (_blocks)
+        {
+            Block* next = _blocks->next;
+            std::free(_blocks);
+            _blocks = next;
+        }
+
+        _cur  = nullptr;
+        _end  = nullptr;
+        _used = 0;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,132 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Utils/Definitions.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Bump allocator that releases everything it handed out at once.
+    ///
+    /// Memory is carved sequentially from large blocks. Objects that need
+    /// their destructor called are recorded in a list that clear walks in
+    /// creation order before the blocks are freed.
+    class Arena
+    {
+    public:
+        /// <summary>
+        /// The default size of each block.
+        /// </summary>
+        static constexpr size_t BlockSize = 0x10000;
+
+    private:
+        struct Block
+        {
+            Block* next;
+            size_t size;
+        };
+
+        struct Finalizer
+        {
+            Finalizer* next;
+            void*      object;
+            void (*destroy)(void*);
+        };
+
+        Block*     _blocks;
+        char*      _cur;
+        char*      _end;
+        Finalizer* _head;
+        Finalizer* _tail;
+        size_t     _used;
+
+        void* grow(size_t size, size_t align);
+
+        void finalize(void* object, void (*destroy)(void*));
+
+        template <typename T>
+        static void destroy(void* object)
+        {
+            ((T*)object)->~T();
+        }
+
+    public:
+        Arena();
+        ~Arena();
+
+        Arena(const Arena&)            = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /// <summary>
+        /// Reserves uninitialized memory.
+        /// </summary>
+        /// <param name="size">The number of bytes to reserve</param>
+        /// <param name="align">A power of two alignment</param>
+        /// <returns>Memory that remains valid until clear is called.</returns>
+        void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+        /// <summary>
+        /// Constructs a T in arena memory.
+        /// </summary>
+        /// <remarks>
+        /// The object must not be deleted, it is destroyed by clear.
+        /// </remarks>
+        template <typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                finalize(object, &destroy<T>);
+            return object;
+        }
+
+        /// <summary>
+        /// Destroys every object created by the arena and frees its blocks.
+        /// </summary>
+        void clear();
+
+        /// <returns>The number of bytes handed out since the last clear.</returns>
+        size_t used() const;
+    };
+
+    inline void* Arena::allocate(const size_t size, const size_t align)
+    {
+        const size_t addr = ((size_t)_cur + (align - 1)) & ~(align - 1);
+        if (_cur == nullptr || addr + size > (size_t)_end)
+            return grow(size, align);
+
+        _cur = (char*)addr + size;
+        _used += size;
+        return (char*)addr;
+    }
+
+    inline size_t Arena::used() const
+    {
+        return _used;
+    }
+}  // namespace Rt2::Json
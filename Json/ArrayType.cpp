@@ -36,14 +36,27 @@ namespace Rt2::Json
 
     ArrayType::~ArrayType()
     {
-        for (const auto& it : _array)
-            delete it;
+        // the element array doubles as the stack of types to release
+        releaseAll(_array);
+    }
+
+    void ArrayType::detach(Array<Type*>& dest)
+    {
+        for (Type* it : _array)
+        {
+            if (it && !it->isArenaAllocated())
+                dest.push_back(it);
+        }
+        _array.clear();
     }
 
     void ArrayType::add(Type* value)
     {
         if (value)
+        {
+            _flags &= ~FROZEN;
             _array.push_back(value);
+        }
     }
 
     void ArrayType::add(const I16& value)
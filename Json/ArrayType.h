@@ -41,6 +41,9 @@ namespace Rt2::Json
     private:
         TypeArray _array;
 
+    protected:
+        void detach(Array<Type*>& dest) override;
+
     public:
         /// <summary>
         /// Default array constructor.
@@ -136,13 +139,23 @@ namespace Rt2::Json
             return i < _array.size() ? _array.at(i) : nullptr;
         }
 
+        /// <summary>
+        /// Get the array element at the supplied index.
+        /// </summary>
+        /// <param name="i">position to access</param>
+        /// <returns>skJsonType or null if the index is out of bounds.</returns>
+        const Type* at(const U32 i) const
+        {
+            return i < _array.size() ? _array.at(i) : nullptr;
+        }
+
         /// <summary>
         /// Attempts to convert the type at the supplied index to an integer.
         /// </summary>
         /// <param name="i">The array position to access</param>
         /// <param name="def">Is the return value on any error condition.</param>
         /// <returns>An integer or the supplied default if the index is null or out of bounds. </returns>
-        I16 i16(const U32 i, const I16 def = -1)
+        I16 i16(const U32 i, const I16 def = -1) const
         {
             const Type* type = at(i);
             if (!type || !type->isInteger())
@@ -156,7 +169,7 @@ namespace Rt2::Json
         /// <param name="i">The array position to access</param>
         /// <param name="def">Is the return value on any error condition.</param>
         /// <returns>An integer or the supplied default if the index is null or out of bounds. </returns>
-        I32 i32(const U32 i, const I32 def = -1)
+        I32 i32(const U32 i, const I32 def = -1) const
         {
             const Type* type = at(i);
             if (!type || !type->isInteger())
@@ -170,7 +183,7 @@ namespace Rt2::Json
         /// <param name="i">The array position to access</param>
         /// <param name="def">Is the return value on any error condition.</param>
         /// <returns>An integer or the supplied default if the index is null or out of bounds. </returns>
-        I64 i64(const U32 i, const I64 def = -1)
+        I64 i64(const U32 i, const I64 def = -1) const
         {
             const Type* type = at(i);
             if (!type || !type->isInteger())
@@ -29,36 +29,22 @@ namespace Rt2::Json
     /// \ingroup Json
     class BoolType final : public Type
     {
-    private:
-        bool _bool;
-
-        void notifyStringChanged() override
-        {
-            _bool = Char::toBool(_value);
-        }
-
-        void notifyValueChanged() override
-        {
-            Char::toString(_value, _bool);
-        }
-
     public:
         BoolType() :
-            Type(BOOLEAN),
-            _bool(false)
+            Type(BOOLEAN)
         {
         }
 
         explicit BoolType(const bool val) :
-            Type(BOOLEAN),
-            _bool(val)
+            Type(BOOLEAN)
         {
+            _scalar.boolean = val;
             notifyValueChanged();
         }
 
         void toString(StringBuilder& dest) override
         {
-            if (_bool)
+            if (_scalar.boolean)
                 dest.write("true");
             else
                 dest.write("false");
@@ -0,0 +1,138 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Json/Dictionary.h"
+
+namespace Rt2::Json
+{
+    Dictionary::Dictionary(KeyTable* keys) :
+        _size(0),
+        _keys(keys),
+        _ownsKeys(false)
+    {
+    }
+
+    Dictionary::~Dictionary()
+    {
+        if (_ownsKeys)
+            delete _keys;
+    }
+
+    KeyTable& Dictionary::keys()
+    {
+        if (!_keys)
+        {
+            _keys     = new KeyTable();
+            _ownsKeys = true;
+        }
+        return *_keys;
+    }
+
+    void Dictionary::clear()
+    {
+        _size = 0;
+        _entries.clear();
+        _slots.clear();
+    }
+
+    void Dictionary::link(const U32 index)
+    {
+        // Slots hold index + 1 so that zero marks an empty slot.
+        const U32 mask = _slots.size() - 1;
+
+        U32 slot = (U32)_entries[index].symbol->hash & mask;
+        while (_slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        _slots[slot] = index + 1;
+    }
+
+    void Dictionary::grow()
+    {
+        const U32 capacity = _slots.empty() ? 32 : _slots.size() * 2;
+
+        _slots.clear();
+        _slots.resize(capacity);
+        for (U32 i = 0; i < capacity; ++i)
+            _slots[i] = 0;
+
+        for (U32 i = 0; i < _entries.size(); ++i)
+            link(i);
+    }
+
+    void Dictionary::spill()
+    {
+        _entries.reserve(InlineCapacity * 2);
+        for (U32 i = 0; i < InlineCapacity; ++i)
+            _entries.push_back(_inline[i]);
+        grow();
+    }
+
+    size_t Dictionary::find(const Symbol* key) const
+    {
+        if (key == nullptr)
+            return Npos;
+
+        if (isInline())
+        {
+            for (U32 i = 0; i < _size; ++i)
+            {
+                if (_inline[i].symbol == key)
+                    return i;
+            }
+            return Npos;
+        }
+
+        const U32 mask = _slots.size() - 1;
+
+        U32 slot = (U32)key->hash & mask;
+        while (const U32 ref = _slots[slot])
+        {
+            if (_entries[ref - 1].symbol == key)
+                return ref - 1;
+            slot = (slot + 1) & mask;
+        }
+        return Npos;
+    }
+
+    bool Dictionary::insert(const Symbol* key, Type* value)
+    {
+        if (find(key) != Npos)
+            return false;
+
+        if (_size < InlineCapacity)
+        {
+            _inline[_size++] = {key, value};
+            return true;
+        }
+
+        if (_size == InlineCapacity)
+            spill();
+
+        _entries.push_back({key, value});
+        ++_size;
+
+        if (_size * 2 > _slots.size())
+            grow();
+        else
+            link(_size - 1);
+        return true;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,250 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/KeyTable.h"
+#include "Utils/Array.h"
+
+namespace Rt2::Json
+{
+    class Type;
+
+    /// \ingroup Json
+    ///
+    /// Insertion ordered map from interned keys to values.
+    ///
+    /// Keys are interned in a KeyTable and compared by symbol pointer, so
+    /// nothing is hashed or compared character by character here. Up to
+    /// InlineCapacity entries are stored in the dictionary itself and found
+    /// with a linear scan. Past that the entries move to the heap and are
+    /// indexed by the hash that was stored when the key was interned.
+    ///
+    /// String keys are resolved through the table, and iterating yields
+    /// members whose first is the key's text, as with a HashTable<String, Type*>.
+    class Dictionary
+    {
+    public:
+        /// <summary>
+        /// The number of entries that are stored without a heap allocation.
+        /// </summary>
+        static constexpr U32 InlineCapacity = 8;
+
+        /// <summary>
+        /// A key and value, as seen while iterating.
+        /// </summary>
+        struct Member
+        {
+            const String& first;
+            Type*         second;
+            const Symbol* symbol;
+        };
+
+    private:
+        struct Entry
+        {
+            const Symbol* symbol;
+            Type*         second;
+        };
+
+    public:
+        class Iterator
+        {
+        private:
+            struct Arrow
+            {
+                Member member;
+
+                const Member* operator->() const
+                {
+                    return &member;
+                }
+            };
+
+            const Entry* _entry;
+
+        public:
+            explicit Iterator(const Entry* entry) :
+                _entry(entry)
+            {
+            }
+
+            Member operator*() const
+            {
+                return {_entry->symbol->text, _entry->second, _entry->symbol};
+            }
+
+            Arrow operator->() const
+            {
+                return {**this};
+            }
+
+            Iterator& operator++()
+            {
+                ++_entry;
+                return *this;
+            }
+
+            bool operator==(const Iterator& rhs) const
+            {
+                return _entry == rhs._entry;
+            }
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return _entry != rhs._entry;
+            }
+        };
+
+    private:
+        Entry        _inline[InlineCapacity];
+        U32          _size;
+        Array<Entry> _entries;
+        Array<U32>   _slots;
+        KeyTable*    _keys;
+        bool         _ownsKeys;
+
+        void grow();
+
+        void link(U32 index);
+
+        void spill();
+
+        bool isInline() const;
+
+        Entry* data();
+
+        const Entry* data() const;
+
+    public:
+        /// <summary>
+        /// Constructs a dictionary whose keys are interned in the supplied table.
+        /// </summary>
+        /// <param name="keys">
+        /// A table that outlives the dictionary, or null to create a private
+        /// table on the first insert.
+        /// </param>
+        explicit Dictionary(KeyTable* keys = nullptr);
+        ~Dictionary();
+
+        Dictionary(const Dictionary&)            = delete;
+        Dictionary& operator=(const Dictionary&) = delete;
+
+        /// <returns>The table that interns the keys.</returns>
+        KeyTable& keys();
+
+        /// <returns>The position of the key, or Npos if it is not present.</returns>
+        size_t find(const Symbol* key) const;
+
+        /// <returns>The position of the key, or Npos if it is not present.</returns>
+        size_t find(const String& key) const;
+
+        /// <returns>The position of the key, or Npos if it is not present.</returns>
+        size_t find(const Key& key) const;
+
+        /// <summary>
+        /// Appends the key and value unless the key is already present.
+        /// </summary>
+        /// <returns>true if the value was inserted.</returns>
+        bool insert(const Symbol* key, Type* value);
+
+        /// <summary>
+        /// Interns the key and appends the key and value unless the key is
+        /// already present.
+        /// </summary>
+        /// <returns>true if the value was inserted.</returns>
+        bool insert(const String& key, Type* value);
+
+        Type*& at(size_t pos);
+
+        Type* at(size_t pos) const;
+
+        U32 size() const;
+
+        bool empty() const;
+
+        void clear();
+
+        Iterator begin() const;
+
+        Iterator end() const;
+    };
+
+    inline bool Dictionary::isInline() const
+    {
+        return _size <= InlineCapacity;
+    }
+
+    inline Dictionary::Entry* Dictionary::data()
+    {
+        return isInline() ? _inline : &_entries[0];
+    }
+
+    inline const Dictionary::Entry* Dictionary::data() const
+    {
+        return isInline() ? _inline : &_entries[0];
+    }
+
+    inline Type*& Dictionary::at(const size_t pos)
+    {
+        return data()[pos].second;
+    }
+
+    inline Type* Dictionary::at(const size_t pos) const
+    {
+        return data()[pos].second;
+    }
+
+    inline U32 Dictionary::size() const
+    {
+        return _size;
+    }
+
+    inline bool Dictionary::empty() const
+    {
+        return _size == 0;
+    }
+
+    inline Dictionary::Iterator Dictionary::begin() const
+    {
+        return Iterator(data());
+    }
+
+    inline Dictionary::Iterator Dictionary::end() const
+    {
+        return Iterator(data() + _size);
+    }
+
+    inline size_t Dictionary::find(const String& key) const
+    {
+        return _keys ? find(_keys->find(key)) : Npos;
+    }
+
+    inline size_t Dictionary::find(const Key& key) const
+    {
+        return _keys ? find(_keys->find(key)) : Npos;
+    }
+
+    inline bool Dictionary::insert(const String& key, Type* value)
+    {
+        return insert(keys().intern(key), value);
+    }
+}  // namespace Rt2::Json
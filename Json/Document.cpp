@@ -0,0 +1,74 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Document.h"
+#include "MemoryObjectVisitor.h"
+#include "Parser.h"
+
+namespace Rt2::Json
+{
+    Document::Document() :
+        _root(nullptr),
+        _lazy(false)
+    {
+    }
+
+    Document::~Document()
+    {
+        clear();
+    }
+
+    void Document::clear()
+    {
+        _root = nullptr;
+        _arena.clear();
+        _keys.clear();
+    }
+
+    const Type* Document::freeze()
+    {
+        if (_root)
+            _root->freeze();
+        return _root;
+    }
+
+    Type* Document::parse(const String& path)
+    {
+        clear();
+
+        MemoryObjectVisitor visitor(this);
+        Parser              parser(&visitor);
+        visitor.setLazyNumbers(_lazy);
+        _root = parser.parse(path);
+        return _root;
+    }
+
+    Type* Document::parse(const char* src, const size_t sizeInBytes, const size_t padding)
+    {
+        clear();
+
+        MemoryObjectVisitor visitor(this);
+        Parser              parser(&visitor);
+        visitor.setLazyNumbers(_lazy);
+        _root = parser.parse(src, sizeInBytes, padding);
+        return _root;
+    }
+}  // namespace Rt2::Json
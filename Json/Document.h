@@ -0,0 +1,144 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Arena.h"
+#include "Json/KeyTable.h"
+#include "Json/Type.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Owns a parsed tree and every node in it.
+    ///
+    /// Nodes are constructed in the document's arena, so parsing does not
+    /// call the heap once per value and destroying the document releases
+    /// the whole tree in a single pass. Nodes must not be deleted
+    /// individually, and any pointer into the tree is invalid once the
+    /// document is cleared or destroyed.
+    class Document
+    {
+    private:
+        Arena    _arena;
+        KeyTable _keys;
+        Type*    _root;
+        bool     _lazy;
+
+    public:
+        Document();
+        ~Document();
+
+        Document(const Document&)            = delete;
+        Document& operator=(const Document&) = delete;
+
+        /// <summary>
+        /// Replaces the contents of the document with the parsed file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <returns>The new root, or null if the file could not be parsed.</returns>
+        Type* parse(const String& path);
+
+        /// <summary>
+        /// Replaces the contents of the document with the parsed memory.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <param name="padding">See Parser::parse</param>
+        /// <returns>The new root, or null if the memory could not be parsed.</returns>
+        Type* parse(const char* src, size_t sizeInBytes, size_t padding = 0);
+
+        /// <summary>
+        /// When enabled, numbers are decoded on first access rather than
+        /// while parsing, and untouched numbers print their source text.
+        /// </summary>
+        void setLazyNumbers(bool lazy);
+
+        /// <summary>
+        /// Constructs a T that is owned by this document.
+        /// </summary>
+        template <typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            T* type = _arena.create<T>(std::forward<Args>(args)...);
+            type->_flags |= Type::ARENA;
+            return type;
+        }
+
+        /// <summary>
+        /// Destroys every node that belongs to the document.
+        /// </summary>
+        void clear();
+
+        /// <returns>The root of the document, or null if it is empty.</returns>
+        Type* root() const;
+
+        /// <summary>
+        /// Makes the tree safe to share between threads, see Type::freeze.
+        /// </summary>
+        /// <returns>The root of the document, or null if it is empty.</returns>
+        /// <remarks>
+        /// Readers should only be given the returned pointer. Parsing again
+        /// or clearing the document invalidates it.
+        /// </remarks>
+        const Type* freeze();
+
+        /// <summary>
+        /// Replaces the root of the document.
+        /// </summary>
+        /// <param name="root">A type that was created by this document</param>
+        void setRoot(Type* root);
+
+        /// <returns>The number of arena bytes in use.</returns>
+        size_t bytesUsed() const;
+
+        /// <returns>
+        /// The table that interns the keys of every object in the document.
+        /// </returns>
+        KeyTable& keys();
+    };
+
+    inline Type* Document::root() const
+    {
+        return _root;
+    }
+
+    inline void Document::setRoot(Type* root)
+    {
+        _root = root;
+    }
+
+    inline void Document::setLazyNumbers(const bool lazy)
+    {
+        _lazy = lazy;
+    }
+
+    inline size_t Document::bytesUsed() const
+    {
+        return _arena.used();
+    }
+
+    inline KeyTable& Document::keys()
+    {
+        return _keys;
+    }
+}  // namespace Rt2::Json
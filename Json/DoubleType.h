@@ -20,6 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #pragma once
+#include "Json/Number.h"
 #include "Json/Type.h"
 
 
@@ -28,36 +29,29 @@ namespace Rt2::Json
 
     class DoubleType final : public Type
     {
-    private:
-        double _double;
-
-        void notifyStringChanged() override
-        {
-            _double = Char::toDouble(_value);
-        }
-
-        void notifyValueChanged() override
-        {
-            Char::toString(_value, _double);
-        }
-
     public:
         DoubleType() :
-            Type(DOUBLE),
-            _double(0.0)
+            Type(DOUBLE)
         {
         }
 
         explicit DoubleType(const double& v) :
-            Type(DOUBLE),
-            _double(v)
+            Type(DOUBLE)
         {
+            _scalar.r64 = v;
             notifyValueChanged();
         }
 
         void toString(StringBuilder& dest) override
         {
-            dest.write(_double);
+            if (_flags & RAW_TEXT)
+                dest.write(_value);
+            else
+            {
+                char buf[Number::DoubleBufferSize];
+                Number::formatDouble(_scalar.r64, buf);
+                dest.write(buf);
+            }
         }
     };
 }  // namespace Rt2::Json
@@ -21,6 +21,7 @@
 */
 #pragma once
 
+#include "Json/Number.h"
 #include "Json/Type.h"
 
 namespace Rt2::Json
@@ -29,47 +30,32 @@ namespace Rt2::Json
     /// \ingroup Json
     class IntegerType final : public Type
     {
-    private:
-        typedef union Integer
-        {
-            I16 i16[4];
-            I32 i32[2];
-            I64 i64;
-            U16 u16[4];
-            U32 u32[2];
-            U64 u64;
-        } Integer;
-
-        Integer _integer;
-
-        void notifyStringChanged() override
-        {
-            _integer.i64 = Char::toInt64(_value);
-        }
-
-        void notifyValueChanged() override
-        {
-            Char::toString(_value, _integer.i64);
-        }
-
     public:
         IntegerType() :
-            Type(INTEGER),
-            _integer({})
+            Type(INTEGER)
         {
         }
 
         explicit IntegerType(const I64& val) :
-            Type(INTEGER),
-            _integer({})
+            Type(INTEGER)
         {
-            _integer.i64 = val;
+            _scalar.i64 = val;
             notifyValueChanged();
         }
 
         void toString(StringBuilder& dest) override
         {
-            dest.write(_integer.i64);
+            if (_flags & RAW_TEXT)
+                dest.write(_value);
+            else
+            {
+                char buf[Number::IntegerBufferSize];
+                if (_flags & UNSIGNED)
+                    Number::formatUnsigned(_scalar.u64, buf);
+                else
+                    Number::formatInteger(_scalar.i64, buf);
+                dest.write(buf);
+            }
         }
     };
 }  // namespace Rt2::Json
@@ -0,0 +1,98 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Json/KeyTable.h"
+
+namespace Rt2::Json
+{
+    KeyTable::~KeyTable()
+    {
+        clear();
+    }
+
+    void KeyTable::clear()
+    {
+        for (const Symbol* symbol : _symbols)
+            delete symbol;
+        _symbols.clear();
+        _slots.clear();
+    }
+
+    void KeyTable::link(const Symbol* symbol)
+    {
+        // Slots hold id + 1 so that zero marks an empty slot.
+        const U32 mask = _slots.size() - 1;
+
+        U32 slot = (U32)symbol->hash & mask;
+        while (_slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        _slots[slot] = symbol->id + 1;
+    }
+
+    void KeyTable::grow()
+    {
+        const U32 capacity = _slots.empty() ? 64 : _slots.size() * 2;
+
+        _slots.clear();
+        _slots.resize(capacity);
+        for (U32 i = 0; i < capacity; ++i)
+            _slots[i] = 0;
+
+        for (const Symbol* symbol : _symbols)
+            link(symbol);
+    }
+
+    const Symbol* KeyTable::find(const char* str, const size_t len, const U64 hash) const
+    {
+        if (_slots.empty())
+            return nullptr;
+
+        const U32 mask = _slots.size() - 1;
+
+        U32 slot = (U32)hash & mask;
+        while (const U32 ref = _slots[slot])
+        {
+            const Symbol* symbol = _symbols[ref - 1];
+            if (symbol->hash == hash &&
+                symbol->text.size() == len &&
+                symbol->text.compare(0, len, str, len) == 0)
+                return symbol;
+            slot = (slot + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    const Symbol* KeyTable::intern(const char* str, const size_t len)
+    {
+        const U64 h = hash(str, len);
+        if (const Symbol* found = find(str, len, h))
+            return found;
+
+        // keep the load factor at or below one half
+        if ((_symbols.size() + 1) * 2 > _slots.size())
+            grow();
+
+        Symbol* symbol = new Symbol{String(str, len), h, _symbols.size()};
+        _symbols.push_back(symbol);
+        link(symbol);
+        return symbol;
+    }
+}  // namespace Rt2::Json
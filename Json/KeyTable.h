@@ -0,0 +1,202 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Utils/Array.h"
+#include "Utils/String.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// An interned object key.
+    ///
+    /// Every distinct key in a KeyTable is stored exactly once, so two
+    /// symbols from the same table are equal only if they are the same
+    /// pointer.
+    struct Symbol
+    {
+        String text;
+        U64    hash;
+        U32    id;
+    };
+
+    /// \ingroup Json
+    ///
+    /// A precomputed lookup key.
+    ///
+    /// Constructing a Key from a literal hashes it at compile time, so a
+    /// lookup through a Key neither builds a String nor hashes the text.
+    /// <code>
+    /// static constexpr Key Timestamp("timestamp");
+    /// obj->i64(Timestamp);
+    /// </code>
+    /// A Key refers to the characters it was built from, they must stay
+    /// valid for as long as the Key is used.
+    class Key
+    {
+    private:
+        const char* _text;
+        size_t      _size;
+        U64         _hash;
+
+    public:
+        template <size_t N>
+        explicit constexpr Key(const char (&str)[N]);
+
+        constexpr Key(const char* str, size_t len);
+
+        constexpr const char* text() const
+        {
+            return _text;
+        }
+
+        constexpr size_t size() const
+        {
+            return _size;
+        }
+
+        constexpr U64 hash() const
+        {
+            return _hash;
+        }
+    };
+
+    /// \ingroup Json
+    ///
+    /// Stores the keys of every ObjectType that shares it.
+    ///
+    /// A parse interns each key as it is read, so a key that is repeated
+    /// across thousands of objects is stored and hashed once. Symbols are
+    /// never moved, and they stay valid until the table is cleared or
+    /// destroyed.
+    class KeyTable
+    {
+    private:
+        Array<Symbol*> _symbols;
+        Array<U32>     _slots;
+
+        void grow();
+
+        void link(const Symbol* symbol);
+
+    public:
+        KeyTable() = default;
+        ~KeyTable();
+
+        KeyTable(const KeyTable&)            = delete;
+        KeyTable& operator=(const KeyTable&) = delete;
+
+        /// <summary>
+        /// 64-bit FNV-1a hash of the supplied characters.
+        /// </summary>
+        static constexpr U64 hash(const char* str, size_t len)
+        {
+            U64 h = 0xCBF29CE484222325;
+            for (size_t i = 0; i < len; ++i)
+            {
+                h ^= (U8)str[i];
+                h *= 0x100000001B3;
+            }
+            return h;
+        }
+
+        /// <summary>
+        /// Returns the symbol for the supplied key, adding it if it is not
+        /// in the table yet.
+        /// </summary>
+        const Symbol* intern(const char* str, size_t len);
+
+        /// <summary>
+        /// Returns the symbol for the supplied key, adding it if it is not
+        /// in the table yet.
+        /// </summary>
+        const Symbol* intern(const String& str);
+
+        /// <summary>
+        /// Returns the symbol for the supplied key and precomputed hash,
+        /// or null if the key has not been interned.
+        /// </summary>
+        const Symbol* find(const char* str, size_t len, U64 hash) const;
+
+        /// <summary>
+        /// Returns the symbol for the supplied key, or null if the key has
+        /// not been interned.
+        /// </summary>
+        const Symbol* find(const String& str) const;
+
+        /// <summary>
+        /// Returns the symbol for the supplied key, or null if the key has
+        /// not been interned.
+        /// </summary>
+        const Symbol* find(const Key& key) const;
+
+        /// <returns>The symbol with the supplied id.</returns>
+        const Symbol* at(U32 id) const;
+
+        /// <returns>The number of distinct keys in the table.</returns>
+        U32 size() const;
+
+        /// <summary>
+        /// Destroys every symbol in the table.
+        /// </summary>
+        void clear();
+    };
+
+    template <size_t N>
+    constexpr Key::Key(const char (&str)[N]) :
+        Key(str, N - 1)
+    {
+    }
+
+    constexpr Key::Key(const char* str, const size_t len) :
+        _text(str),
+        _size(len),
+        _hash(KeyTable::hash(str, len))
+    {
+    }
+
+    inline const Symbol* KeyTable::find(const Key& key) const
+    {
+        return find(key.text(), key.size(), key.hash());
+    }
+
+    inline const Symbol* KeyTable::intern(const String& str)
+    {
+        return intern(str.c_str(), str.size());
+    }
+
+    inline const Symbol* KeyTable::find(const String& str) const
+    {
+        return find(str.c_str(), str.size(), hash(str.c_str(), str.size()));
+    }
+
+    inline const Symbol* KeyTable::at(const U32 id) const
+    {
+        return _symbols.at(id);
+    }
+
+    inline U32 KeyTable::size() const
+    {
+        return _symbols.size();
+    }
+}  // namespace Rt2::Json
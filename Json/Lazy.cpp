@@ -0,0 +1,366 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Json/Lazy.h"
+#include "Json/Number.h"
+#include "Utils/Console.h"
+
+namespace Rt2::Json
+{
+    namespace
+    {
+        bool isValue(const Token& tok)
+        {
+            switch (tok.type())
+            {
+            case JT_L_BRACE:
+            case JT_L_BRACKET:
+            case JT_STRING:
+            case JT_BOOL:
+            case JT_NUMBER:
+            case JT_INTEGER:
+                return true;
+            case JT_NULL:
+                return !tok.view().empty();  // an empty view is the end of input
+            default:
+                return false;
+            }
+        }
+    }  // namespace
+
+    LazyDocument::LazyDocument() :
+        _stamp(0),
+        _ids(0),
+        _pending(false),
+        _failed(false)
+    {
+    }
+
+    void LazyDocument::reset()
+    {
+        _open.clear();
+        _tok.clear();
+        _key.clear();
+        _pending = false;
+        _failed  = false;
+
+        // stamps and ids keep counting so that handles from an earlier
+        // parse never match
+        ++_stamp;
+    }
+
+    LazyValue LazyDocument::parse(const String& path)
+    {
+        reset();
+        _scanner.open(path);
+
+        if (!_scanner.isOpen())
+        {
+            Console::writeError("failed to open the supplied file: ", path.c_str());
+            _failed = true;
+            return {};
+        }
+        return start();
+    }
+
+    LazyValue LazyDocument::parse(const char* src, const size_t sizeInBytes, const size_t padding)
+    {
+        reset();
+        _scanner.borrow(src, sizeInBytes, padding);
+
+        if (!_scanner.isOpen())
+        {
+            Console::writeError("failed to open the supplied memory file");
+            _failed = true;
+            return {};
+        }
+        return start();
+    }
+
+    LazyValue LazyDocument::start()
+    {
+        _scanner.scan(_tok);
+        if (!isValue(_tok))
+        {
+            fail();
+            return {};
+        }
+        _pending = true;
+        return {this, ++_stamp};
+    }
+
+    bool LazyDocument::fail()
+    {
+        Console::writeError("Parse error: ", _tok.value().c_str());
+        _failed  = true;
+        _pending = false;
+        _open.clear();
+        ++_stamp;
+        return false;
+    }
+
+    bool LazyDocument::settle(const U32 level)
+    {
+        // pass over the current value if the caller did not step into it
+        if (_pending)
+        {
+            _pending = false;
+            if (!_scanner.skip(_tok))
+                return fail();
+        }
+
+        // then close anything that was stepped into and left unfinished
+        while (_open.size() > level)
+        {
+            Token open;
+            open.setType(_open.back().object ? JT_L_BRACKET : JT_L_BRACE);
+            if (!_scanner.skip(open))
+                return fail();
+            _open.pop_back();
+        }
+        return true;
+    }
+
+    bool LazyDocument::enter(const U64 stamp, const TokenType open, U32& level, U64& id)
+    {
+        const bool object = open == JT_L_BRACKET;
+
+        // a value that was already stepped into returns the same container
+        for (U32 i = 0; i < _open.size(); ++i)
+        {
+            if (const Frame& frame = _open.at(i); frame.stamp == stamp)
+            {
+                if (frame.object != object)
+                    return false;
+                level = i + 1;
+                id    = frame.id;
+                return true;
+            }
+        }
+
+        if (_failed || !_pending || _stamp != stamp || _tok.type() != open)
+            return false;
+
+        _pending = false;
+        _open.push_back({++_ids, stamp, object, false});
+        level = _open.size();
+        id    = _ids;
+        return true;
+    }
+
+    bool LazyDocument::next(const U32 level, const U64 id, const bool object, LazyValue& dest)
+    {
+        if (!isOpen(level, id) || !settle(level))
+            return false;
+
+        const TokenType close = object ? JT_R_BRACKET : JT_R_BRACE;
+
+        // objects read the key into its own token so that it stays valid
+        // while the value is current
+        Token& first = object ? _key : _tok;
+        Frame& frame = _open.back();
+
+        if (frame.started)
+        {
+            _scanner.scan(_tok);
+            if (_tok.type() == close)
+            {
+                _open.pop_back();
+                ++_stamp;
+                return false;
+            }
+            if (_tok.type() != JT_COMMA)
+                return fail();
+            _scanner.scan(first);
+        }
+        else
+        {
+            frame.started = true;
+            _scanner.scan(first);
+            if (first.type() == close)
+            {
+                _open.pop_back();
+                ++_stamp;
+                return false;
+            }
+        }
+
+        if (object)
+        {
+            if (_key.type() != JT_STRING)
+                return fail();
+            _scanner.scan(_tok);
+            if (_tok.type() != JT_COLON)
+                return fail();
+            _scanner.scan(_tok);
+        }
+
+        if (!isValue(_tok))
+            return fail();
+
+        _pending = true;
+        dest     = {this, ++_stamp};
+        return true;
+    }
+
+    bool LazyValue::valid() const
+    {
+        return token() != nullptr;
+    }
+
+    Type::ClassType LazyValue::type() const
+    {
+        const Token* tok = token();
+        if (!tok)
+            return Type::UNDEFINED;
+
+        switch (tok->type())
+        {
+        case JT_L_BRACE:
+            return Type::ARRAY;
+        case JT_L_BRACKET:
+            return Type::OBJECT;
+        case JT_STRING:
+            return Type::STRING;
+        case JT_INTEGER:
+            return Type::INTEGER;
+        case JT_NUMBER:
+            return Type::DOUBLE;
+        case JT_BOOL:
+            return Type::BOOLEAN;
+        case JT_NULL:
+            return Type::POINTER;
+        default:
+            return Type::UNDEFINED;
+        }
+    }
+
+    StringView LazyValue::string() const
+    {
+        const Token* tok = token();
+        if (!tok || tok->type() != JT_STRING)
+            return {};
+        return tok->view();
+    }
+
+    I32 LazyValue::i32(const I32 defaultValue) const
+    {
+        return (I32)i64(defaultValue);
+    }
+
+    I64 LazyValue::i64(const I64 defaultValue) const
+    {
+        const Token* tok = token();
+        if (!tok || tok->type() != JT_INTEGER || !tok->hasInteger())
+            return defaultValue;
+        return tok->integer();
+    }
+
+    U64 LazyValue::u64(const U64 defaultValue) const
+    {
+        const Token* tok = token();
+        if (!tok || tok->type() != JT_INTEGER)
+            return defaultValue;
+
+        if (tok->hasInteger())
+            return tok->integer() < 0 ? defaultValue : (U64)tok->integer();
+
+        // integers above the signed range are not decoded by the scanner
+        const StringView text = tok->view();
+        const char*      cur  = text.data();
+
+        U64 value;
+        if (!Number::parseUnsigned(cur, text.data() + text.size(), value) ||
+            cur != text.data() + text.size())
+            return defaultValue;
+        return value;
+    }
+
+    double LazyValue::r64(const double defaultValue) const
+    {
+        const Token* tok = token();
+        if (!tok || tok->type() != JT_NUMBER)
+            return defaultValue;
+
+        const StringView text = tok->view();
+
+        double value;
+        if (!Number::parseDouble(text.data(), text.data() + text.size(), value))
+            return defaultValue;
+        return value;
+    }
+
+    bool LazyValue::boolean(const bool defaultValue) const
+    {
+        const Token* tok = token();
+        if (!tok || tok->type() != JT_BOOL)
+            return defaultValue;
+        return tok->view() == "true";
+    }
+
+    bool LazyValue::isNull() const
+    {
+        const Token* tok = token();
+        return tok && tok->type() == JT_NULL;
+    }
+
+    LazyArray LazyValue::array() const
+    {
+        U32 level;
+        U64 id;
+        if (!_doc || !_doc->enter(_stamp, JT_L_BRACE, level, id))
+            return {};
+        return {_doc, level, id};
+    }
+
+    LazyObject LazyValue::object() const
+    {
+        U32 level;
+        U64 id;
+        if (!_doc || !_doc->enter(_stamp, JT_L_BRACKET, level, id))
+            return {};
+        return {_doc, level, id};
+    }
+
+    LazyValue LazyValue::operator[](const StringView& key) const
+    {
+        return object().find(key);
+    }
+
+    bool LazyObject::next(Member& dest) const
+    {
+        if (!_doc || !_doc->next(_level, _id, true, dest.second))
+            return false;
+        dest.first = _doc->_key.view();
+        return true;
+    }
+
+    LazyValue LazyObject::find(const StringView& key) const
+    {
+        Member member;
+        while (next(member))
+        {
+            if (member.first == key)
+                return member.second;
+        }
+        return {};
+    }
+}  // namespace Rt2::Json
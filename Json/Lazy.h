@@ -0,0 +1,429 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Scanner.h"
+#include "Json/Token.h"
+#include "Json/Type.h"
+#include "Utils/Array.h"
+
+namespace Rt2::Json
+{
+    class LazyArray;
+    class LazyDocument;
+    class LazyObject;
+
+    /// \ingroup Json
+    ///
+    /// Handle to a value that a LazyDocument has reached but not decoded.
+    ///
+    /// Nothing is converted until one of the accessors is called, and the
+    /// conversion reads the scanned token directly. A value can only be
+    /// read while it is the current value of its document. Once the
+    /// enclosing array or object moves on, the handle becomes invalid and
+    /// the accessors return their defaults.
+    class LazyValue
+    {
+    private:
+        LazyDocument* _doc;
+        U64           _stamp;
+
+        const Token* token() const;
+
+        friend class LazyArray;
+        friend class LazyDocument;
+        friend class LazyObject;
+
+        LazyValue(LazyDocument* doc, const U64 stamp) :
+            _doc(doc),
+            _stamp(stamp)
+        {
+        }
+
+    public:
+        LazyValue() :
+            _doc(nullptr),
+            _stamp(0)
+        {
+        }
+
+        /// <returns>false if the handle no longer references the current value.</returns>
+        bool valid() const;
+
+        /// <returns>The Type class code that corresponds to the value.</returns>
+        Type::ClassType type() const;
+
+        /// <returns>
+        /// The characters of a string value, or an empty view for any other
+        /// type. The view is valid until the document moves on.
+        /// </returns>
+        StringView string() const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER.
+        I32 i32(I32 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER.
+        I64 i64(I64 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is negative.
+        U64 u64(U64 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not a DOUBLE.
+        double r64(double defaultValue = 0.0) const;
+
+        /// Returns the value or the default parameter if it is not a BOOLEAN.
+        bool boolean(bool defaultValue = false) const;
+
+        /// <returns>true if the value is null</returns>
+        bool isNull() const;
+
+        /// <summary>
+        /// Steps into an array value.
+        /// </summary>
+        /// <returns>An array handle, which is invalid if the value is not an array.</returns>
+        LazyArray array() const;
+
+        /// <summary>
+        /// Steps into an object value.
+        /// </summary>
+        /// <returns>An object handle, which is invalid if the value is not an object.</returns>
+        LazyObject object() const;
+
+        /// <summary>
+        /// Shorthand for object().find(key).
+        /// </summary>
+        LazyValue operator[](const StringView& key) const;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Forward-only view of an array in a LazyDocument.
+    ///
+    /// Each step reads the next element from the source. An element that
+    /// was not read, or was only partly read, is skipped with Scanner::skip.
+    class LazyArray
+    {
+    private:
+        LazyDocument* _doc;
+        U32           _level;
+        U64           _id;
+
+        friend class LazyValue;
+
+        LazyArray(LazyDocument* doc, const U32 level, const U64 id) :
+            _doc(doc),
+            _level(level),
+            _id(id)
+        {
+        }
+
+    public:
+        class Iterator
+        {
+        private:
+            const LazyArray* _array;
+            LazyValue        _value;
+            bool             _done;
+
+        public:
+            Iterator(const LazyArray* array, const bool done) :
+                _array(array),
+                _done(done || !_array->next(_value))
+            {
+            }
+
+            const LazyValue& operator*() const
+            {
+                return _value;
+            }
+
+            const LazyValue* operator->() const
+            {
+                return &_value;
+            }
+
+            Iterator& operator++()
+            {
+                _done = !_array->next(_value);
+                return *this;
+            }
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return _done != rhs._done;
+            }
+        };
+
+        LazyArray() :
+            _doc(nullptr),
+            _level(0),
+            _id(0)
+        {
+        }
+
+        /// <returns>false if the handle does not reference an open array.</returns>
+        bool valid() const;
+
+        /// <summary>
+        /// Moves to the next element.
+        /// </summary>
+        /// <param name="dest">Receives the element.</param>
+        /// <returns>false at the end of the array or on an error.</returns>
+        bool next(LazyValue& dest) const;
+
+        Iterator begin() const;
+
+        Iterator end() const;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Forward-only view of an object in a LazyDocument.
+    ///
+    /// Members are visited in document order. find only searches the
+    /// members that follow the current one, so lookups should be made in
+    /// the order the keys appear in the source.
+    class LazyObject
+    {
+    public:
+        struct Member
+        {
+            /// Valid until the next key in the document is read
+            StringView first;
+            LazyValue  second;
+        };
+
+    private:
+        LazyDocument* _doc;
+        U32           _level;
+        U64           _id;
+
+        friend class LazyValue;
+
+        LazyObject(LazyDocument* doc, const U32 level, const U64 id) :
+            _doc(doc),
+            _level(level),
+            _id(id)
+        {
+        }
+
+    public:
+        class Iterator
+        {
+        private:
+            const LazyObject* _object;
+            Member            _member;
+            bool              _done;
+
+        public:
+            Iterator(const LazyObject* object, const bool done) :
+                _object(object),
+                _done(done || !_object->next(_member))
+            {
+            }
+
+            const Member& operator*() const
+            {
+                return _member;
+            }
+
+            const Member* operator->() const
+            {
+                return &_member;
+            }
+
+            Iterator& operator++()
+            {
+                _done = !_object->next(_member);
+                return *this;
+            }
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return _done != rhs._done;
+            }
+        };
+
+        LazyObject() :
+            _doc(nullptr),
+            _level(0),
+            _id(0)
+        {
+        }
+
+        /// <returns>false if the handle does not reference an open object.</returns>
+        bool valid() const;
+
+        /// <summary>
+        /// Moves to the next member.
+        /// </summary>
+        /// <param name="dest">Receives the key and value.</param>
+        /// <returns>false at the end of the object or on an error.</returns>
+        bool next(Member& dest) const;
+
+        /// <summary>
+        /// Moves forward to the member with the supplied key.
+        /// </summary>
+        /// <returns>The member's value, or an invalid handle if no later member has the key.</returns>
+        LazyValue find(const StringView& key) const;
+
+        Iterator begin() const;
+
+        Iterator end() const;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Reads a document on demand, in the style of simdjson's ondemand API.
+    ///
+    /// No Type nodes are created. The document is a single cursor over the
+    /// source, and the handles it returns move that cursor forward as
+    /// arrays and objects are iterated. Values are decoded only when an
+    /// accessor is called. Whatever the caller does not look at is skipped
+    /// without being tokenized.
+    ///
+    /// <code>
+    /// LazyDocument doc;
+    /// for (LazyValue item : doc.parse(src, len)["items"].array())
+    ///     total += item["price"].r64();
+    /// </code>
+    ///
+    /// The source memory is read in place and must stay valid while the
+    /// document is used. Parts of the source that are never reached are
+    /// not validated.
+    class LazyDocument
+    {
+    private:
+        struct Frame
+        {
+            U64  id;
+            U64  stamp;
+            bool object;
+            bool started;
+        };
+
+        Scanner      _scanner;
+        Token        _tok;
+        Token        _key;
+        Array<Frame> _open;
+        U64          _stamp;
+        U64          _ids;
+        bool         _pending;
+        bool         _failed;
+
+        friend class LazyArray;
+        friend class LazyObject;
+        friend class LazyValue;
+
+        void reset();
+
+        LazyValue start();
+
+        bool fail();
+
+        bool settle(U32 level);
+
+        bool isOpen(U32 level, U64 id) const;
+
+        bool enter(U64 stamp, TokenType open, U32& level, U64& id);
+
+        bool next(U32 level, U64 id, bool object, LazyValue& dest);
+
+    public:
+        LazyDocument();
+
+        LazyDocument(const LazyDocument&)            = delete;
+        LazyDocument& operator=(const LazyDocument&) = delete;
+
+        /// <summary>
+        /// Starts reading the supplied file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <returns>The root value, which is invalid if the file could not be read.</returns>
+        LazyValue parse(const String& path);
+
+        /// <summary>
+        /// Starts reading the supplied memory.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <param name="padding">See Parser::parse</param>
+        /// <returns>The root value.</returns>
+        LazyValue parse(const char* src, size_t sizeInBytes, size_t padding = 0);
+
+        /// <returns>true if a syntax error was found.</returns>
+        bool failed() const;
+    };
+
+    inline bool LazyDocument::failed() const
+    {
+        return _failed;
+    }
+
+    inline bool LazyDocument::isOpen(const U32 level, const U64 id) const
+    {
+        return !_failed && level > 0 && level <= _open.size() && _open.at(level - 1).id == id;
+    }
+
+    inline const Token* LazyValue::token() const
+    {
+        if (_doc && _doc->_pending && _doc->_stamp == _stamp)
+            return &_doc->_tok;
+        return nullptr;
+    }
+
+    inline bool LazyArray::valid() const
+    {
+        return _doc && _doc->isOpen(_level, _id);
+    }
+
+    inline bool LazyArray::next(LazyValue& dest) const
+    {
+        return _doc && _doc->next(_level, _id, false, dest);
+    }
+
+    inline LazyArray::Iterator LazyArray::begin() const
+    {
+        return {this, false};
+    }
+
+    inline LazyArray::Iterator LazyArray::end() const
+    {
+        return {this, true};
+    }
+
+    inline bool LazyObject::valid() const
+    {
+        return _doc && _doc->isOpen(_level, _id);
+    }
+
+    inline LazyObject::Iterator LazyObject::begin() const
+    {
+        return {this, false};
+    }
+
+    inline LazyObject::Iterator LazyObject::end() const
+    {
+        return {this, true};
+    }
+}  // namespace Rt2::Json
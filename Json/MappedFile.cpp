@@ -0,0 +1,174 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "MappedFile.h"
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Rt2::Json
+{
+    // Upper bound for a single istream::read call in the fallback path.
+    constexpr size_t ReadChunk = 0x40000000;
+
+    MappedFile::MappedFile() :
+        _data(nullptr),
+        _size(0),
+        _buffer(nullptr)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const String& path)
+    {
+        close();
+
+        if (!map(path) && !read(path))
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (_buffer)
+            delete[] _buffer;
+        else if (_data)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(_data);
+#else
+            munmap((void*)_data, _size);
+#endif
+        }
+        _data   = nullptr;
+        _buffer = nullptr;
+        _size   = 0;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::map(const String& path)
+    {
+        const HANDLE file = CreateFileA(path.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_FLAG_SEQUENTIAL_SCAN,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER len;
+        if (!GetFileSizeEx(file, &len) || len.QuadPart <= 0 ||
+            (U64)len.QuadPart > (U64)SIZE_MAX)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+
+        // The view keeps the mapping object alive after its handle is closed.
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+            return false;
+
+        _data = (const char*)view;
+        _size = (size_t)len.QuadPart;
+        return true;
+    }
+#else
+    bool MappedFile::map(const String& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            return false;
+
+        struct stat st = {};
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+            (U64)st.st_size > (U64)SIZE_MAX)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+            return false;
+
+        madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+        _data = (const char*)view;
+        _size = (size_t)st.st_size;
+        return true;
+    }
+#endif
+
+    bool MappedFile::read(const String& path)
+    {
+        InputFileStream fs(path.c_str(), std::ios::ate | std::ios::binary);
+        if (!fs.is_open())
+            return false;
+
+        const std::streamoff len = fs.tellg();
+        if (len <= 0 || (U64)len > (U64)SIZE_MAX - 1)
+            return false;
+
+        fs.seekg(0, std::ios::beg);
+        _size   = (size_t)len;
+        _buffer = new char[_size + 1];
+
+        for (size_t pos = 0; pos < _size;)
+        {
+            const size_t chunk = Min<size_t>(ReadChunk, _size - pos);
+            if (!fs.read(_buffer + pos, (std::streamsize)chunk))
+                return false;
+            pos += chunk;
+        }
+
+        _buffer[_size] = 0;
+        _data          = _buffer;
+        return true;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,90 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Utils/Definitions.h"
+#include "Utils/String.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Read-only view of a file's contents.
+    ///
+    /// The file is memory mapped when the platform allows it, otherwise
+    /// its contents are read into a heap buffer. Either way the contents
+    /// are exposed as a single contiguous block with no size limit.
+    class MappedFile
+    {
+    private:
+        const char* _data;
+        size_t      _size;
+        char*       _buffer;
+
+        bool map(const String& path);
+
+        bool read(const String& path);
+
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// <summary>
+        /// Opens the supplied file, releasing any previously opened file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <returns>true if the file is open and is not empty.</returns>
+        bool open(const String& path);
+
+        /// <summary>
+        /// Unmaps or frees the current contents.
+        /// </summary>
+        void close();
+
+        /// <returns>The first byte of the file or null if it is not open.</returns>
+        const char* data() const;
+
+        /// <returns>The size of the file in bytes.</returns>
+        size_t size() const;
+
+        /// <returns>true if the contents are backed by a memory mapping.</returns>
+        bool isMapped() const;
+    };
+
+    inline const char* MappedFile::data() const
+    {
+        return _data;
+    }
+
+    inline size_t MappedFile::size() const
+    {
+        return _size;
+    }
+
+    inline bool MappedFile::isMapped() const
+    {
+        return _data != nullptr && _buffer == nullptr;
+    }
+}  // namespace Rt2::Json
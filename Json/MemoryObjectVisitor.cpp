@@ -22,6 +22,7 @@
 #include "MemoryObjectVisitor.h"
 #include "ArrayType.h"
 #include "BoolType.h"
+#include "Document.h"
 #include "DoubleType.h"
 #include "IntegerType.h"
 #include "ObjectType.h"
@@ -33,35 +34,67 @@
 
 namespace Rt2::Json
 {
+    MemoryObjectVisitor::MemoryObjectVisitor(Document* document) :
+        _document(document),
+        _keys(&document->keys())
+    {
+    }
+
     MemoryObjectVisitor::~MemoryObjectVisitor()
+    {
+        reset();
+    }
+
+    void MemoryObjectVisitor::reset()
     {
         clear();
 
-        delete _root;
+        Type::release(_root);
         _root = nullptr;
     }
 
+    template <typename T, typename... Args>
+    T* MemoryObjectVisitor::create(Args&&... args)
+    {
+        if (_document)
+            return _document->create<T>(std::forward<Args>(args)...);
+        return new T(std::forward<Args>(args)...);
+    }
+
+    void MemoryObjectVisitor::setLazyNumbers(const bool lazy)
+    {
+        _lazy = lazy;
+    }
+
+    void MemoryObjectVisitor::assign(Type* obj, const StringView& value) const
+    {
+        if (_lazy && (obj->isInteger() || obj->isDouble()))
+            obj->setRaw(value);
+        else
+            obj->setValue(value);
+    }
+
     void MemoryObjectVisitor::clear()
     {
         while (!_arrStack.empty())
         {
-            delete _arrStack.top();
+            Type::release(_arrStack.top());
             _arrStack.pop();
         }
         while (!_objStack.empty())
         {
-            delete _objStack.top();
+            Type::release(_objStack.top());
             _objStack.pop();
         }
         while (!_finishedObjects.empty())
         {
-            delete _finishedObjects.top();
+            Type::release(_finishedObjects.top());
             _finishedObjects.pop();
         }
-        while (!_finishedObjects.empty())
+        while (!_finishedArrays.empty())
         {
-            delete _finishedObjects.top();
-            _finishedObjects.pop();
+            Type::release(_finishedArrays.top());
+            _finishedArrays.pop();
         }
     }
 
@@ -88,12 +121,12 @@ namespace Rt2::Json
 
     void MemoryObjectVisitor::arrayCreated()
     {
-        _arrStack.push(new ArrayType());
+        _arrStack.push(create<ArrayType>());
     }
 
     void MemoryObjectVisitor::objectCreated()
     {
-        _objStack.push(new ObjectType());
+        _objStack.push(create<ObjectType>(_keys));
     }
 
     void MemoryObjectVisitor::objectFinished()
@@ -114,9 +147,9 @@ namespace Rt2::Json
         }
     }
 
-    void MemoryObjectVisitor::keyValueParsed(const String&    key,
-                                             const TokenType& valueType,
-                                             const String&    value)
+    void MemoryObjectVisitor::keyValueParsed(const StringView& key,
+                                             const TokenType&  valueType,
+                                             const StringView& value)
     {
         if (_objStack.empty())
         {
@@ -144,19 +177,19 @@ namespace Rt2::Json
             }
             break;
         case JT_STRING:
-            obj = new StringType();
+            obj = create<StringType>();
             break;
         case JT_NULL:
-            obj = new PointerType();
+            obj = create<PointerType>();
             break;
         case JT_BOOL:
-            obj = new BoolType();
+            obj = create<BoolType>();
             break;
         case JT_NUMBER:
-            obj = new DoubleType();
+            obj = create<DoubleType>();
             break;
         case JT_INTEGER:
-            obj = new IntegerType();
+            obj = create<IntegerType>();
             break;
         case JT_UNDEFINED:
         case JT_COLON:
@@ -167,15 +200,34 @@ namespace Rt2::Json
         }
 
         if (obj != nullptr)
-            obj->setValue(value);
-        top->insert(key, obj);
+            assign(obj, value);
+        top->insert(_keys->intern(key.data(), key.size()), obj);
     }
 
-    void MemoryObjectVisitor::handleArrayType(Type* obj, const String& value)
+    void MemoryObjectVisitor::keyIntegerParsed(const StringView& key,
+                                               const StringView& value,
+                                               const I64&        integer)
+    {
+        if (_lazy)
+        {
+            // keep the source text, see setLazyNumbers
+            keyValueParsed(key, JT_INTEGER, value);
+            return;
+        }
+        if (_objStack.empty())
+        {
+            Console::writeError("no object on the parse stack\n");
+            return;
+        }
+        _objStack.top()->insert(_keys->intern(key.data(), key.size()),
+                                create<IntegerType>(integer));
+    }
+
+    void MemoryObjectVisitor::handleArrayType(Type* obj, const StringView& value)
     {
         if (obj != nullptr)
         {
-            obj->setValue(value);
+            assign(obj, value);
             auto* arrayObject = _arrStack.top();
             arrayObject->add(obj);
         }
@@ -199,35 +251,43 @@ namespace Rt2::Json
         }
     }
 
-    void MemoryObjectVisitor::stringParsed(const String& value)
+    void MemoryObjectVisitor::stringParsed(const StringView& value)
     {
         if (!_arrStack.empty())
-            handleArrayType(new ArrayType(), value);
+            handleArrayType(create<StringType>(), value);
     }
 
-    void MemoryObjectVisitor::integerParsed(const String& value)
+    void MemoryObjectVisitor::integerParsed(const StringView& value)
     {
         if (!_arrStack.empty())
-            handleArrayType(new IntegerType(), value);
+            handleArrayType(create<IntegerType>(), value);
+    }
+
+    void MemoryObjectVisitor::integerValueParsed(const StringView& value, const I64& integer)
+    {
+        if (_lazy)
+            integerParsed(value);
+        else if (!_arrStack.empty())
+            _arrStack.top()->add(create<IntegerType>(integer));
     }
 
-    void MemoryObjectVisitor::doubleParsed(const String& value)
+    void MemoryObjectVisitor::doubleParsed(const StringView& value)
     {
         if (!_arrStack.empty())
-            handleArrayType(new DoubleType(), value);
+            handleArrayType(create<DoubleType>(), value);
     }
 
-    void MemoryObjectVisitor::booleanParsed(const String& value)
+    void MemoryObjectVisitor::booleanParsed(const StringView& value)
     {
         if (!_arrStack.empty())
-            handleArrayType(new DoubleType(), value);
+            handleArrayType(create<BoolType>(), value);
     }
 
-    void MemoryObjectVisitor::pointerParsed(const String& value)
+    void MemoryObjectVisitor::pointerParsed(const StringView& value)
     {
         if (!_arrStack.empty())
         {
-            handleArrayType(new PointerType(), value);
+            handleArrayType(create<PointerType>(), value);
         }
     }
 }  // namespace Rt2::Json
\ No newline at end of file
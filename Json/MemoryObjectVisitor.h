@@ -21,6 +21,7 @@
 */
 #pragma once
 
+#include "KeyTable.h"
 #include "ObjectType.h"
 #include "Token.h"
 #include "Utils/Stack.h"
@@ -28,6 +29,8 @@
 
 namespace Rt2::Json
 {
+    class Document;
+
     /// <summary>
     /// Default visitor
     /// Creates type wrappers for parsed json types.
@@ -39,19 +42,46 @@ namespace Rt2::Json
         typedef Stack<ArrayType*>  ArrayStack;
 
     private:
+        Document*   _document{nullptr};
+        KeyTable    _ownKeys{};
+        KeyTable*   _keys{&_ownKeys};
         Type*       _root{nullptr};
         ObjectStack _objStack{};
         ArrayStack  _arrStack{};
         ObjectStack _finishedObjects{};
         ArrayStack  _finishedArrays{};
+        bool        _lazy{false};
+
+        template <typename T, typename... Args>
+        T* create(Args&&... args);
+
+        void assign(Type* obj, const StringView& value) const;
 
     public:
         MemoryObjectVisitor() = default;
 
+        /// <summary>
+        /// Constructs the parsed types in the supplied document
+        /// rather than on the heap.
+        /// </summary>
+        explicit MemoryObjectVisitor(Document* document);
+
         ~MemoryObjectVisitor() override;
 
         void clear();
 
+        /// <summary>
+        /// Releases the nodes of a partly parsed document and the root of
+        /// the last one, so that another document can be built.
+        /// </summary>
+        void reset();
+
+        /// <summary>
+        /// When enabled, numbers keep their source text and are only
+        /// decoded when a typed accessor is first called. See Type::setRaw.
+        /// </summary>
+        void setLazyNumbers(bool lazy);
+
         void parseError(const Token& last) override;
 
         Type* root() override;
@@ -64,25 +94,31 @@ namespace Rt2::Json
 
         void arrayFinished() override;
 
-        void keyValueParsed(const String&    key,
-                            const TokenType& valueType,
-                            const String&    value) override;
+        void keyValueParsed(const StringView& key,
+                            const TokenType&  valueType,
+                            const StringView& value) override;
 
-        void handleArrayType(Type* obj, const String& value);
+        void keyIntegerParsed(const StringView& key,
+                              const StringView& value,
+                              const I64&        integer) override;
+
+        void handleArrayType(Type* obj, const StringView& value);
 
         void objectParsed() override;
 
         void arrayParsed() override;
 
-        void stringParsed(const String& value) override;
+        void stringParsed(const StringView& value) override;
+
+        void integerParsed(const StringView& value) override;
 
-        void integerParsed(const String& value) override;
+        void integerValueParsed(const StringView& value, const I64& integer) override;
 
-        void doubleParsed(const String& value) override;
+        void doubleParsed(const StringView& value) override;
 
-        void booleanParsed(const String& value) override;
+        void booleanParsed(const StringView& value) override;
 
-        void pointerParsed(const String& value) override;
+        void pointerParsed(const StringView& value) override;
     };
 
 }  // namespace Rt2::Json
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Json/NdJsonReader.h"
+#include <cstring>
+#include "Json/MappedFile.h"
+#include "Json/MemoryObjectVisitor.h"
+#include "Json/Parser.h"
+#include "Json/Scanner.h"
+#include "Utils/Console.h"
+#if RT_OPEN_MP
+    #include <omp.h>
+#endif
+
+namespace Rt2::Json
+{
+    namespace
+    {
+        bool isBlank(const char* first, const char* last)
+        {
+            for (; first < last; ++first)
+            {
+                if (*first != ' ' && *first != '\t' && *first != '\r')
+                    return false;
+            }
+            return true;
+        }
+
+        // Parses one record into the document. Unlike Parser::parse the
+        // record must hold nothing but white space after the value.
+        void parseRecord(Document& doc, const char* src, const size_t len, const size_t padding)
+        {
+            doc.clear();
+
+            MemoryObjectVisitor visitor(&doc);
+            Parser              parser(&visitor);
+
+            Scanner scn;
+            scn.borrow(src, len, padding);
+
+            Token tok;
+            scn.scan(tok);
+
+            Type* root = parser.parse(scn, tok);
+            if (root)
+            {
+                scn.scan(tok);
+                if (!scn.isOpen() || tok.type() != JT_NULL || !tok.view().empty())
+                    root = nullptr;
+            }
+            doc.setRoot(root);
+        }
+    }  // namespace
+
+    NdJsonReader::NdJsonReader() :
+        _batchSize(DefaultBatchSize),
+        _threads(0)
+    {
+    }
+
+    NdJsonReader::~NdJsonReader()
+    {
+        for (const Document* doc : _documents)
+            delete doc;
+    }
+
+    void NdJsonReader::parseBatch(const char* end, const size_t padding)
+    {
+        while (_documents.size() < _records.size())
+            _documents.push_back(new Document());
+
+        const I64 count = (I64)_records.size();
+
+#if RT_OPEN_MP
+        const int threads = _threads > 0 ? (int)_threads : omp_get_max_threads();
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(threads) if (count > 1)
+#endif
+        for (I64 i = 0; i < count; ++i)
+        {
+            const Record& rec = _records[(size_t)i];
+
+            // the bytes of the records that follow are readable too
+            parseRecord(*_documents[(size_t)i],
+                        rec.src,
+                        rec.len,
+                        (size_t)(end - (rec.src + rec.len)) + padding);
+        }
+    }
+
+    bool NdJsonReader::deliver(Listener& listener)
+    {
+        bool result = true;
+        for (size_t i = 0; i < _records.size() && result; ++i)
+            result = listener.recordParsed(_records[i].line, _documents[i]->root());
+
+        for (size_t i = 0; i < _records.size(); ++i)
+            _documents[i]->clear();
+        _records.clear();
+        return result;
+    }
+
+    bool NdJsonReader::read(const String& path, Listener& listener)
+    {
+        MappedFile file;
+        if (!file.open(path))
+        {
+            Console::writeError("failed to open the supplied file: ", path.c_str());
+            return false;
+        }
+        return read(file.data(), file.size(), listener);
+    }
+
+    bool NdJsonReader::read(const char*  src,
+                            const size_t sizeInBytes,
+                            Listener&    listener,
+                            const size_t padding)
+    {
+        if (!src)
+            return true;
+
+        _records.clear();
+        _records.reserve(_batchSize);
+
+        const char* cur  = src;
+        const char* end  = src + sizeInBytes;
+        size_t      line = 0;
+
+        while (cur < end)
+        {
+            const char* next = (const char*)std::memchr(cur, '\n', (size_t)(end - cur));
+            if (!next)
+                next = end;
+
+            if (!isBlank(cur, next))
+                _records.push_back({cur, (size_t)(next - cur), line});
+
+            if (_records.size() >= _batchSize)
+            {
+                parseBatch(end, padding);
+                if (!deliver(listener))
+                    return false;
+            }
+
+            if (next == end)
+                break;
+            cur = next + 1;
+            ++line;
+        }
+
+        if (!_records.empty())
+        {
+            parseBatch(end, padding);
+            return deliver(listener);
+        }
+        return true;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,156 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Document.h"
+#include "Utils/Array.h"
+#include "Utils/String.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Reads newline-delimited json (NDJSON, JSON Lines).
+    ///
+    /// Each non-blank line of the input is a separate object or array. The
+    /// input is split into batches of lines, and the records of a batch are
+    /// parsed in parallel when the library is built with RT_OPEN_MP. Every
+    /// record is built in its own Document, and once the whole batch is
+    /// parsed the records are handed to a Listener in input order.
+    ///
+    /// Strings in json cannot hold a raw line feed, so a line feed always
+    /// ends a record.
+    class NdJsonReader
+    {
+    public:
+        /// <summary>
+        /// The default number of records that are parsed together.
+        /// </summary>
+        static constexpr size_t DefaultBatchSize = 1024;
+
+        /// <summary>
+        /// Receives the records of the input.
+        /// </summary>
+        class Listener
+        {
+        public:
+            virtual ~Listener() = default;
+
+            /// <summary>
+            /// Called once for every record, in input order.
+            /// </summary>
+            /// <param name="line">The zero based line that holds the record</param>
+            /// <param name="root">
+            /// The parsed record, or null if the line is not a single valid
+            /// object or array. It is owned by the reader and is only valid
+            /// until this call returns.
+            /// </param>
+            /// <returns>false to stop reading.</returns>
+            virtual bool recordParsed(size_t line, Type* root) = 0;
+        };
+
+    private:
+        struct Record
+        {
+            const char* src;
+            size_t      len;
+            size_t      line;
+        };
+
+        Array<Record>    _records;
+        Array<Document*> _documents;
+        size_t           _batchSize;
+        U32              _threads;
+
+        void parseBatch(const char* end, size_t padding);
+
+        bool deliver(Listener& listener);
+
+    public:
+        NdJsonReader();
+        ~NdJsonReader();
+
+        NdJsonReader(const NdJsonReader&)            = delete;
+        NdJsonReader& operator=(const NdJsonReader&) = delete;
+
+        /// <summary>
+        /// Sets the number of records that are parsed before any of them
+        /// are delivered. Larger batches spread better across threads but
+        /// hold more parsed records in memory at once.
+        /// </summary>
+        void setBatchSize(size_t records);
+
+        /// <returns>The number of records in a batch.</returns>
+        size_t batchSize() const;
+
+        /// <summary>
+        /// Sets the number of threads that parse a batch.
+        /// Zero uses the OpenMP default.
+        /// </summary>
+        void setThreadCount(U32 threads);
+
+        /// <returns>The requested number of threads.</returns>
+        U32 threadCount() const;
+
+        /// <summary>
+        /// Reads every record in the supplied file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <param name="listener">Receives each record</param>
+        /// <returns>false if the file could not be opened or the listener stopped.</returns>
+        bool read(const String& path, Listener& listener);
+
+        /// <summary>
+        /// Reads every record in the supplied memory.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <param name="listener">Receives each record</param>
+        /// <param name="padding">See Parser::parse</param>
+        /// <returns>false if the listener stopped.</returns>
+        /// <remarks>
+        /// A malformed record is passed to the listener as null and does not
+        /// stop the read.
+        /// </remarks>
+        bool read(const char* src, size_t sizeInBytes, Listener& listener, size_t padding = 0);
+    };
+
+    inline void NdJsonReader::setBatchSize(const size_t records)
+    {
+        _batchSize = records > 0 ? records : 1;
+    }
+
+    inline size_t NdJsonReader::batchSize() const
+    {
+        return _batchSize;
+    }
+
+    inline void NdJsonReader::setThreadCount(const U32 threads)
+    {
+        _threads = threads;
+    }
+
+    inline U32 NdJsonReader::threadCount() const
+    {
+        return _threads;
+    }
+}  // namespace Rt2::Json
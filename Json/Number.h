@@ -0,0 +1,201 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include <cstring>
+#include "Utils/Definitions.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Conversions between json number text and binary values.
+    class Number
+    {
+    public:
+        /// <summary>
+        /// A number split into its decimal parts, value = mantissa * 10^exponent.
+        /// </summary>
+        struct Decimal
+        {
+            U64  mantissa;
+            I64  exponent;
+            bool negative;
+            /// There is no fraction or exponent
+            bool integer;
+            /// The mantissa only holds the leading MaxDigits significant digits
+            bool truncated;
+        };
+
+        /// <summary>
+        /// The most digits a 64-bit magnitude can be accumulated from
+        /// without wrapping.
+        /// </summary>
+        static constexpr size_t MaxDigits = 19;
+
+        /// <summary>
+        /// Loads 8 bytes so that the first character is in the low byte.
+        /// </summary>
+        static U64 load(const char* src);
+
+        /// <returns>true if all 8 bytes of chunk are ASCII digits.</returns>
+        static bool isEightDigits(U64 chunk);
+
+        /// <summary>
+        /// Converts 8 ASCII digits with three multiplies instead of eight.
+        /// </summary>
+        /// <param name="chunk">Digits loaded by load</param>
+        static U32 parseEightDigits(U64 chunk);
+
+        /// <summary>
+        /// Parses an optional minus sign followed by decimal digits.
+        /// </summary>
+        /// <param name="cur">
+        /// The first character. On return it points past the last digit.
+        /// </param>
+        /// <param name="last">One past the last readable character</param>
+        /// <param name="dest">Receives the value</param>
+        /// <returns>
+        /// false if there were no digits or the value does not fit in an I64.
+        /// </returns>
+        static bool parseInteger(const char*& cur, const char* last, I64& dest);
+
+        /// <summary>
+        /// Parses decimal digits without a sign.
+        /// </summary>
+        /// <param name="cur">
+        /// The first character. On return it points past the last digit.
+        /// </param>
+        /// <param name="last">One past the last readable character</param>
+        /// <param name="dest">Receives the value</param>
+        /// <returns>
+        /// false if there were no digits or the value does not fit in a U64.
+        /// </returns>
+        static bool parseUnsigned(const char*& cur, const char* last, U64& dest);
+
+        /// <summary>
+        /// Recognizes a number with the json grammar,
+        /// <code> -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? </code>
+        /// </summary>
+        /// <param name="cur">
+        /// The first character. On success it points past the number.
+        /// </param>
+        /// <param name="last">One past the last readable character</param>
+        /// <param name="dest">Receives the decimal parts</param>
+        /// <returns>false if the characters do not start with a valid number.</returns>
+        static bool scan(const char*& cur, const char* last, Decimal& dest);
+
+        /// <summary>
+        /// Converts an integer Decimal.
+        /// </summary>
+        /// <returns>false if it is not an integer or does not fit in an I64.</returns>
+        static bool toInt64(const Decimal& dec, I64& dest);
+
+        /// <summary>
+        /// Converts the decimal parts to the nearest double with the
+        /// Clinger and Eisel-Lemire algorithms.
+        /// </summary>
+        /// <returns>
+        /// false in the rare cases that need the exact conversion in parseDouble.
+        /// </returns>
+        static bool toDouble(const Decimal& dec, double& dest);
+
+        /// <summary>
+        /// Converts json number text to the nearest double.
+        /// </summary>
+        /// <param name="first">The first character of the number</param>
+        /// <param name="last">One past the last character of the number</param>
+        /// <param name="dest">Receives the value</param>
+        /// <returns>false if the text is not exactly one json number.</returns>
+        static bool parseDouble(const char* first, const char* last, double& dest);
+
+        /// <summary>
+        /// The buffer size that formatDouble requires.
+        /// </summary>
+        static constexpr size_t DoubleBufferSize = 32;
+
+        /// <summary>
+        /// Writes the shortest text that parses back to the same double.
+        /// </summary>
+        /// <param name="value">The value to format</param>
+        /// <param name="dest">A buffer of at least DoubleBufferSize bytes</param>
+        /// <returns>The number of characters written, excluding the terminating null.</returns>
+        /// <remarks>
+        /// Whole numbers get a ".0" suffix so that they are read back as
+        /// doubles, and values that json cannot represent are written as null.
+        /// </remarks>
+        static size_t formatDouble(double value, char* dest);
+
+        /// <summary>
+        /// The buffer size that formatInteger requires.
+        /// </summary>
+        static constexpr size_t IntegerBufferSize = 24;
+
+        /// <summary>
+        /// Writes the decimal text of an integer, two digits at a time.
+        /// </summary>
+        /// <param name="value">The value to format</param>
+        /// <param name="dest">A buffer of at least IntegerBufferSize bytes</param>
+        /// <returns>The number of characters written, excluding the terminating null.</returns>
+        static size_t formatInteger(I64 value, char* dest);
+
+        /// <summary>
+        /// Writes the decimal text of an unsigned integer, two digits at a time.
+        /// </summary>
+        /// <param name="value">The value to format</param>
+        /// <param name="dest">A buffer of at least IntegerBufferSize bytes</param>
+        /// <returns>The number of characters written, excluding the terminating null.</returns>
+        static size_t formatUnsigned(U64 value, char* dest);
+
+        /// <returns>The number of decimal digits in value.</returns>
+        static size_t digitCount(U64 value);
+    };
+
+    inline U64 Number::load(const char* src)
+    {
+        U64 chunk;
+        std::memcpy(&chunk, src, sizeof(U64));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        chunk = __builtin_bswap64(chunk);
+#endif
+        return chunk;
+    }
+
+    inline bool Number::isEightDigits(const U64 chunk)
+    {
+        // '0'..'9' is 0x30..0x39, adding 6 carries out of the low nibble for anything above '9'
+        return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+                (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+    }
+
+    inline U32 Number::parseEightDigits(U64 chunk)
+    {
+        constexpr U64 mask = 0x000000FF000000FF;
+        constexpr U64 mul1 = 0x000F424000000064;  // 100 + (1000000 << 32)
+        constexpr U64 mul2 = 0x0000271000000001;  // 1 + (10000 << 32)
+
+        chunk -= 0x3030303030303030;
+        chunk = chunk * 10 + (chunk >> 8);  // pairs of digits
+        chunk = ((chunk & mask) * mul1 + (chunk >> 16 & mask) * mul2) >> 32;
+        return (U32)chunk;
+    }
+}  // namespace Rt2::Json
@@ -24,6 +24,7 @@
 #include "DoubleType.h"
 #include "IntegerType.h"
 #include "PointerType.h"
+#include "StringType.h"
 
 namespace Rt2::Json
 {
@@ -32,17 +33,43 @@ namespace Rt2::Json
     {
     }
 
+    ObjectType::ObjectType(KeyTable* keys) :
+        Type(OBJECT),
+        _dictionary(keys)
+    {
+    }
+
     ObjectType::~ObjectType()
+    {
+        Array<Type*> children;
+        detach(children);
+        releaseAll(children);
+    }
+
+    void ObjectType::detach(Array<Type*>& dest)
     {
         for (const auto& el : _dictionary)
-            delete el.second;
+        {
+            if (el.second && !el.second->isArenaAllocated())
+                dest.push_back(el.second);
+        }
         _dictionary.clear();
     }
 
+    KeyTable& ObjectType::keys()
+    {
+        return _dictionary.keys();
+    }
+
+    void ObjectType::insert(const Symbol* key, Type* value)
+    {
+        _flags &= ~FROZEN;
+        _dictionary.insert(key, value);
+    }
+
     void ObjectType::insert(const String& key, Type* value)
     {
-        if (const size_t pos = _dictionary.find(key); pos == Npos)
-            _dictionary.insert(key, value);
+        insert(keys().intern(key), value);
     }
 
     bool ObjectType::hasKey(const String& key) const
@@ -58,7 +85,15 @@ namespace Rt2::Json
         return nullptr;
     }
 
-    void ObjectType::string(String& dest, const String& key, const String& def)
+    const Type* ObjectType::find(const String& key) const
+    {
+        if (const size_t pos = _dictionary.find(key);
+            pos != Npos)
+            return _dictionary.at(pos);
+        return nullptr;
+    }
+
+    void ObjectType::string(String& dest, const String& key, const String& def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -67,7 +102,7 @@ namespace Rt2::Json
             dest.assign(def);
     }
 
-    void ObjectType::integer(I64& dest, const String& key, const I64& def)
+    void ObjectType::integer(I64& dest, const String& key, const I64& def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -76,7 +111,7 @@ namespace Rt2::Json
             dest = def;
     }
 
-    void ObjectType::integer(I32& dest, const String& key, const I32& def)
+    void ObjectType::integer(I32& dest, const String& key, const I32& def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -85,7 +120,7 @@ namespace Rt2::Json
             dest = def;
     }
 
-    void ObjectType::integer(I16& dest, const String& key, const I16& def)
+    void ObjectType::integer(I16& dest, const String& key, const I16& def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -94,7 +129,7 @@ namespace Rt2::Json
             dest = def;
     }
 
-    bool ObjectType::boolean(const String& key, const bool def)
+    bool ObjectType::boolean(const String& key, const bool def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -102,7 +137,7 @@ namespace Rt2::Json
         return def;
     }
 
-    double ObjectType::r64(const String& key, const double def)
+    double ObjectType::r64(const String& key, const double def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -110,7 +145,7 @@ namespace Rt2::Json
         return def;
     }
 
-    float ObjectType::r32(const String& key, const float def)
+    float ObjectType::r32(const String& key, const float def) const
     {
         if (const size_t pos = _dictionary.find(key);
             pos != Npos)
@@ -118,6 +153,76 @@ namespace Rt2::Json
         return def;
     }
 
+    bool ObjectType::hasKey(const Key& key) const
+    {
+        return _dictionary.find(key) != Npos;
+    }
+
+    Type* ObjectType::find(const Key& key)
+    {
+        if (const size_t pos = _dictionary.find(key);
+            pos != Npos)
+            return _dictionary.at(pos);
+        return nullptr;
+    }
+
+    const Type* ObjectType::find(const Key& key) const
+    {
+        if (const size_t pos = _dictionary.find(key);
+            pos != Npos)
+            return _dictionary.at(pos);
+        return nullptr;
+    }
+
+    String ObjectType::string(const Key& key, const String& def) const
+    {
+        if (const Type* value = find(key))
+            return value->string();
+        return def;
+    }
+
+    I16 ObjectType::i16(const Key& key, const I16 def) const
+    {
+        if (const Type* value = find(key))
+            return value->i16(def);
+        return def;
+    }
+
+    I32 ObjectType::i32(const Key& key, const I32 def) const
+    {
+        if (const Type* value = find(key))
+            return value->i32(def);
+        return def;
+    }
+
+    I64 ObjectType::i64(const Key& key, const I64 def) const
+    {
+        if (const Type* value = find(key))
+            return value->i64(def);
+        return def;
+    }
+
+    bool ObjectType::boolean(const Key& key, const bool def) const
+    {
+        if (const Type* value = find(key))
+            return value->boolean(def);
+        return def;
+    }
+
+    double ObjectType::r64(const Key& key, const double def) const
+    {
+        if (const Type* value = find(key))
+            return value->r64(def);
+        return def;
+    }
+
+    float ObjectType::r32(const Key& key, const float def) const
+    {
+        if (const Type* value = find(key))
+            return (float)value->r64((double)def);
+        return def;
+    }
+
     void ObjectType::insert(const String& key, const I16& value)
     {
         insert(key, (I64)value);
@@ -130,9 +235,9 @@ namespace Rt2::Json
 
     void ObjectType::insert(const String& key, const I64& value)
     {
-        if (const size_t pos = _dictionary.find(key);
-            pos == Npos)
-            _dictionary.insert(key, new IntegerType(value));
+        if (const Symbol* sym = keys().intern(key);
+            _dictionary.find(sym) == Npos)
+            insert(sym, new IntegerType(value));
     }
 
     void ObjectType::insert(const String& key, const float& value)
@@ -142,27 +247,27 @@ namespace Rt2::Json
 
     void ObjectType::insert(const String& key, const double& value)
     {
-        if (const size_t pos = _dictionary.find(key);
-            pos == Npos)
-            _dictionary.insert(key, new DoubleType(value));
+        if (const Symbol* sym = keys().intern(key);
+            _dictionary.find(sym) == Npos)
+            insert(sym, new DoubleType(value));
     }
 
     void ObjectType::insert(const String& key, const bool& value)
     {
-        if (const size_t pos = _dictionary.find(key);
-            pos == Npos)
-            _dictionary.insert(key, new BoolType(value));
+        if (const Symbol* sym = keys().intern(key);
+            _dictionary.find(sym) == Npos)
+            insert(sym, new BoolType(value));
     }
 
     void ObjectType::insert(const String& key,
                             const void*   value)
     {
-        if (const size_t pos = _dictionary.find(key);
-            pos == Npos)
-            _dictionary.insert(key, new PointerType(value));
+        if (const Symbol* sym = keys().intern(key);
+            _dictionary.find(sym) == Npos)
+            insert(sym, new PointerType(value));
     }
 
-    void ObjectType::floatArray(const String& key, float** dest, int max)
+    void ObjectType::floatArray(const String& key, float** dest, int max) const
     {
         String str;
         string(str, key);
@@ -192,9 +297,7 @@ namespace Rt2::Json
                 dest.write(',');
             else
                 first = false;
-            dest.write('"');
-            dest.write(it.first);
-            dest.write('"');
+            StringType::writeQuoted(dest, it.first);
             dest.write(':');
             dest.write(it.second->toString());
         }
@@ -21,8 +21,9 @@
 */
 #pragma once
 
+#include "Json/Dictionary.h"
+#include "Json/KeyTable.h"
 #include "Json/Type.h"
-#include "Utils/HashMap.h"
 #include "Utils/String.h"
 
 
@@ -32,15 +33,41 @@ namespace Rt2::Json
     class ObjectType final : public Type
     {
     public:
-        using Dictionary = HashTable<String, Type*>;
+        using Dictionary = Json::Dictionary;
 
     protected:
         Dictionary _dictionary;
 
+        void detach(Array<Type*>& dest) override;
+
     public:
         ObjectType();
+
+        /// <summary>
+        /// Constructs an object whose keys are interned in the supplied table.
+        /// </summary>
+        /// <param name="keys">
+        /// A table that outlives the object. Objects created by one parse
+        /// share the same table.
+        /// </param>
+        explicit ObjectType(KeyTable* keys);
+
         ~ObjectType() override;
 
+        /// <returns>
+        /// The table that stores this object's keys. An object that was not
+        /// given a table creates its own on first use.
+        /// </returns>
+        KeyTable& keys();
+
+        /// <summary>
+        /// Inserts a Type object into the dictionary with an interned key.
+        /// </summary>
+        /// <param name="key">A symbol from this object's key table.</param>
+        /// <param name="value">value is the object that is to be
+        /// stored.</param>
+        void insert(const Symbol* key, Type* value);
+
         /// <summary>
         /// Inserts a Type object into the dictionary with a lookup key.
         /// </summary>
@@ -156,6 +183,33 @@ namespace Rt2::Json
         /// <returns>The object if the object is found otherwise returns null</returns>
         Type* find(const String& key);
 
+        /// <summary>
+        /// Gets the Json object that is associated with the key.
+        /// </summary>
+        /// <param name="key">The name of the object to search for.</param>
+        /// <returns>The object if the object is found otherwise returns null</returns>
+        const Type* find(const String& key) const;
+
+        /// <summary>
+        /// Returns true if the object has a field with the supplied key.
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        bool hasKey(const Key& key) const;
+
+        /// <summary>
+        /// Gets the Json object that is associated with the key.
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <returns>The object if the object is found otherwise returns null</returns>
+        Type* find(const Key& key);
+
+        /// <summary>
+        /// Gets the Json object that is associated with the key.
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <returns>The object if the object is found otherwise returns null</returns>
+        const Type* find(const Key& key) const;
+
         /// <summary>
         /// Gets the requested string from the dictionary
         /// </summary>
@@ -163,7 +217,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns>The value for the requested key otherwise def</returns>
-        void string(String& dest, const String& key, const String& def = "");
+        void string(String& dest, const String& key, const String& def = "") const;
 
         /// <summary>
         /// Gets the requested signed 64-bit integer from the dictionary
@@ -172,7 +226,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns>The value for the requested key otherwise def</returns>
-        void integer(I64& dest, const String& key, const I64& def = -1);
+        void integer(I64& dest, const String& key, const I64& def = -1) const;
 
         /// <summary>
         /// Gets the requested signed 32-bit integer from the dictionary
@@ -181,7 +235,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns>The value for the requested key otherwise def</returns>
-        void integer(I32& dest, const String& key, const I32& def = -1);
+        void integer(I32& dest, const String& key, const I32& def = -1) const;
 
         /// <summary>
         /// Gets the requested signed 16-bit integer from the dictionary
@@ -190,7 +244,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns>The value for the requested key otherwise def</returns>
-        void integer(I16& dest, const String& key, const I16& def = -1);
+        void integer(I16& dest, const String& key, const I16& def = -1) const;
 
         /// <summary>
         /// Gets the requested signed 16-bit integer from the dictionary
@@ -198,7 +252,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns></returns>
-        I16 i16(const String& key, const I16& def = -1)
+        I16 i16(const String& key, const I16& def = -1) const
         {
             I16 val;
             integer(val, key, def);
@@ -211,7 +265,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns></returns>
-        I32 i32(const String& key, const I32& def = -1)
+        I32 i32(const String& key, const I32& def = -1) const
         {
             I32 val;
             integer(val, key, def);
@@ -224,7 +278,7 @@ namespace Rt2::Json
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
         /// <returns></returns>
-        I64 i64(const String& key, const I64& def = -1)
+        I64 i64(const String& key, const I64& def = -1) const
         {
             I64 val;
             integer(val, key, def);
@@ -236,21 +290,70 @@ namespace Rt2::Json
         /// </summary>
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
-        bool boolean(const String& key, bool def = false);
+        bool boolean(const String& key, bool def = false) const;
 
         /// <summary>
         /// Gets the requested double precision value from the dictionary
         /// </summary>
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
-        double r64(const String& key, double def = 0.0);
+        double r64(const String& key, double def = 0.0) const;
 
         /// <summary>
         /// Gets the requested single precision value from the dictionary
         /// </summary>
         /// <param name="key">The key to get</param>
         /// <param name="def">The default value if the key is not found.</param>
-        float r32(const String& key, float def = 0.0);
+        float r32(const String& key, float def = 0.0) const;
+
+        /// <summary>
+        /// Gets the requested string from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        String string(const Key& key, const String& def = "") const;
+
+        /// <summary>
+        /// Gets the requested signed 16-bit integer from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        I16 i16(const Key& key, I16 def = -1) const;
+
+        /// <summary>
+        /// Gets the requested signed 32-bit integer from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        I32 i32(const Key& key, I32 def = -1) const;
+
+        /// <summary>
+        /// Gets the requested signed 64-bit integer from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        I64 i64(const Key& key, I64 def = -1) const;
+
+        /// <summary>
+        /// Gets the requested boolean from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        bool boolean(const Key& key, bool def = false) const;
+
+        /// <summary>
+        /// Gets the requested double precision value from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        double r64(const Key& key, double def = 0.0) const;
+
+        /// <summary>
+        /// Gets the requested single precision value from the dictionary
+        /// </summary>
+        /// <param name="key">A precomputed key.</param>
+        /// <param name="def">The default value if the key is not found.</param>
+        float r32(const Key& key, float def = 0.0) const;
 
         /// <summary>
         /// Returns a string representation of the object.
@@ -273,7 +376,7 @@ namespace Rt2::Json
         /// <param name="key"></param>
         /// <param name="dest"></param>
         /// <param name="max"></param>
-        void floatArray(const String& key, float** dest, int max);
+        void floatArray(const String& key, float** dest, int max) const;
 
         Dictionary& dictionary()
         {
@@ -0,0 +1,313 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Json/ParallelParser.h"
+#include <cstring>
+#include "Json/ArrayType.h"
+#include "Json/MappedFile.h"
+#include "Json/MemoryObjectVisitor.h"
+#include "Json/Parser.h"
+#include "Json/Scanner.h"
+#include "Json/Simd.h"
+#include "Json/StructuralIndex.h"
+#include "Utils/Console.h"
+#if RT_OPEN_MP
+    #include <omp.h>
+#endif
+
+namespace Rt2::Json
+{
+    namespace
+    {
+        constexpr I64 NoComma = 0x7FFFFFFFFFFFFFFF;
+
+        bool isSpace(const char ch)
+        {
+            return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+        }
+
+        bool isBlank(const char* first, const char* last)
+        {
+            for (; first < last; ++first)
+            {
+                if (!isSpace(*first))
+                    return false;
+            }
+            return true;
+        }
+    }  // namespace
+
+    ParallelParser::ParallelParser() :
+        _chunkSize(DefaultChunkSize),
+        _threads(0)
+    {
+    }
+
+    ParallelParser::~ParallelParser()
+    {
+        clear();
+        for (const Document* part : _parts)
+            delete part;
+    }
+
+    void ParallelParser::clear()
+    {
+        // the root array reads the elements that live in the parts
+        _document.clear();
+        for (Document* part : _parts)
+            part->clear();
+    }
+
+    U32 ParallelParser::threads() const
+    {
+#if RT_OPEN_MP
+        return _threads > 0 ? _threads : (U32)omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    Type* ParallelParser::parse(const String& path)
+    {
+        clear();
+
+        MappedFile file;
+        if (!file.open(path))
+        {
+            Console::writeError("failed to open the supplied file: ", path.c_str());
+            return nullptr;
+        }
+        return parse(file.data(), file.size());
+    }
+
+    Type* ParallelParser::parse(const char* src, const size_t sizeInBytes, const size_t padding)
+    {
+        clear();
+        if (!src || sizeInBytes == 0)
+            return _document.parse(src, sizeInBytes, padding);
+
+        size_t first = 0, last = sizeInBytes;
+        while (first < last && isSpace(src[first]))
+            ++first;
+        while (last > first && isSpace(src[last - 1]))
+            --last;
+
+        // the body is everything between the brackets of the root
+        if (last - first < 2 || src[first] != '[' || src[last - 1] != ']' ||
+            last - first - 2 < 2 * _chunkSize ||
+            !split(src, first + 1, last - 1))
+            return _document.parse(src, sizeInBytes, padding);
+
+        Type* root = build(src, first + 1, last - 1, sizeInBytes - (last - 1) + padding);
+        if (!root)
+            clear();
+        _document.setRoot(root);
+        return root;
+    }
+
+    bool ParallelParser::split(const char* src, const size_t first, const size_t last)
+    {
+        const size_t count = (last - first + _chunkSize - 1) / _chunkSize;
+        _chunks.resize((U32)count);
+
+        const Simd::ClassifyFunction classify = Simd::classifier();
+
+        const I64 chunks = (I64)count;
+#if RT_OPEN_MP
+    #pragma omp parallel for schedule(static) num_threads(threads())
+#endif
+        for (I64 c = 0; c < chunks; ++c)
+        {
+            Chunk& chunk = _chunks[(U32)c];
+            chunk.first  = first + (size_t)c * _chunkSize;
+            chunk.last   = Min(last, chunk.first + _chunkSize);
+
+            for (Profile& profile : chunk.guess)
+            {
+                profile.depth      = 0;
+                profile.lowest     = 0;
+                profile.commaDepth = NoComma;
+                profile.comment    = false;
+                profile.commas.clear();
+            }
+
+            // an odd run of backslashes before the seam escapes the first byte
+            U64 escaped = 0;
+            for (size_t i = chunk.first; i > first && src[i - 1] == '\\'; --i)
+                escaped ^= 1;
+
+            U64 inString = 0;
+            for (size_t base = chunk.first; base < chunk.last; base += 64)
+            {
+                BlockMasks masks;
+                if (base + 64 <= chunk.last)
+                    classify(src + base, masks);
+                else
+                {
+                    char block[64];
+                    memset(block, ' ', sizeof block);
+                    memcpy(block, src + base, chunk.last - base);
+                    classify(block, masks);
+                }
+
+                const U64 quote   = masks.quote & ~StructuralIndex::findEscaped(masks.backslash, escaped);
+                const U64 strings = StructuralIndex::prefixXor(quote) ^ inString;
+                inString          = (U64)((I64)strings >> 63);
+
+                // Guess 0 starts outside of a string and guess 1 starts
+                // inside of one, which inverts the string mask.
+                for (int g = 0; g < 2; ++g)
+                {
+                    Profile&  profile = chunk.guess[g];
+                    const U64 outside = g == 0 ? ~strings : strings;
+
+                    if (masks.slash & outside)
+                        profile.comment = true;
+
+                    U64 bits = masks.op & outside;
+                    while (bits)
+                    {
+                        const size_t pos = base + Simd::lowestBit(bits);
+                        switch (src[pos])
+                        {
+                        case '[':
+                        case '{':
+                            ++profile.depth;
+                            break;
+                        case ']':
+                        case '}':
+                            if (--profile.depth < profile.lowest)
+                                profile.lowest = profile.depth;
+                            break;
+                        case ',':
+                            // only the shallowest commas can separate root elements
+                            if (profile.depth < profile.commaDepth)
+                            {
+                                profile.commaDepth = profile.depth;
+                                profile.commas.clear();
+                            }
+                            if (profile.depth == profile.commaDepth)
+                                profile.commas.push_back(pos);
+                            break;
+                        default:
+                            break;
+                        }
+                        bits &= bits - 1;
+                    }
+                }
+            }
+            chunk.flips = inString != 0;
+        }
+
+        // join the chunks in order, the first one starts outside of a string
+        _commas.clear();
+
+        int inString = 0;
+        I64 depth    = 0;
+        for (const Chunk& chunk : _chunks)
+        {
+            const Profile& profile = chunk.guess[inString];
+            if (profile.comment || depth + profile.lowest < 0)
+                return false;
+
+            if (profile.commaDepth != NoComma && depth + profile.commaDepth == 0)
+            {
+                for (const size_t pos : profile.commas)
+                    _commas.push_back(pos);
+            }
+            depth += profile.depth;
+            inString ^= chunk.flips ? 1 : 0;
+        }
+        return inString == 0 && depth == 0;
+    }
+
+    Type* ParallelParser::build(const char* src, const size_t first, const size_t last, const size_t padding)
+    {
+        // group whole elements into about four ranges per thread
+        const U32    threadCount = threads();
+        const size_t target      = (last - first) / ((size_t)threadCount * 4) + 1;
+
+        _ranges.clear();
+
+        Range range = {first, last, first, true};
+        for (const size_t pos : _commas)
+        {
+            if (pos - range.first >= target)
+            {
+                range.last = pos;
+                _ranges.push_back(range);
+                range.first = pos + 1;
+            }
+            range.tail = pos + 1;
+        }
+        range.last = last;
+        _ranges.push_back(range);
+
+        while (_parts.size() < _ranges.size())
+            _parts.push_back(new Document());
+
+        const I64 count = (I64)_ranges.size();
+#if RT_OPEN_MP
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threadCount)
+#endif
+        for (I64 r = 0; r < count; ++r)
+        {
+            Range&    part = _ranges[(U32)r];
+            Document& doc  = *_parts[(U32)r];
+
+            // A blank last element is a trailing comma, which only the
+            // last range may end with. When it is the whole range there
+            // is nothing to parse.
+            if (isBlank(src + part.tail, src + part.last))
+            {
+                part.ok = r + 1 == count;
+                if (!part.ok || part.tail == part.first)
+                    continue;
+            }
+
+            MemoryObjectVisitor visitor(&doc);
+            Parser              parser(&visitor);
+
+            Scanner scn;
+            scn.borrow(src + part.first, part.last - part.first, (last - part.last) + padding);
+
+            doc.setRoot(parser.parseElements(scn));
+            part.ok = doc.root() != nullptr;
+        }
+
+        for (const Range& part : _ranges)
+        {
+            if (!part.ok)
+                return nullptr;
+        }
+
+        ArrayType* root = _document.create<ArrayType>();
+        for (U32 r = 0; r < (U32)count; ++r)
+        {
+            ArrayType* part = _parts[r]->root() ? _parts[r]->root()->asArray() : nullptr;
+            if (!part)
+                continue;
+            for (U32 i = 0; i < part->size(); ++i)
+                root->add(part->at(i));
+        }
+        return root;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,171 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Document.h"
+#include "Utils/Array.h"
+#include "Utils/String.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Parses a document whose root is one large array on several threads.
+    ///
+    /// The parse has two phases. First the input is cut into chunks that
+    /// are scanned in parallel for the commas that separate the elements
+    /// of the root array. A chunk cannot know whether it starts inside of
+    /// a string, so it is scanned for both cases at once and the right
+    /// one is picked when the chunks are joined in order. Then runs of
+    /// whole elements are built in parallel, each in its own Document, and
+    /// the elements are gathered into a single root ArrayType.
+    ///
+    /// Inputs that are smaller than two chunks, whose root is not an
+    /// array, or that contain comments are parsed on the calling thread.
+    /// Threads are only used when the library is built with RT_OPEN_MP.
+    class ParallelParser
+    {
+    public:
+        /// <summary>
+        /// The default number of bytes scanned by a thread at a time.
+        /// </summary>
+        static constexpr size_t DefaultChunkSize = 0x100000;
+
+    private:
+        /// The commas of a chunk for one guess of its starting state.
+        struct Profile
+        {
+            I64           depth;
+            I64           lowest;
+            I64           commaDepth;
+            Array<size_t> commas;
+            bool          comment;
+        };
+
+        struct Chunk
+        {
+            size_t  first;
+            size_t  last;
+            bool    flips;
+            Profile guess[2];
+        };
+
+        struct Range
+        {
+            size_t first;
+            size_t last;
+            size_t tail;
+            bool   ok;
+        };
+
+        Document         _document;
+        Array<Document*> _parts;
+        Array<Chunk>     _chunks;
+        Array<size_t>    _commas;
+        Array<Range>     _ranges;
+        size_t           _chunkSize;
+        U32              _threads;
+
+        U32 threads() const;
+
+        bool split(const char* src, size_t first, size_t last);
+
+        Type* build(const char* src, size_t first, size_t last, size_t padding);
+
+    public:
+        ParallelParser();
+        ~ParallelParser();
+
+        ParallelParser(const ParallelParser&)            = delete;
+        ParallelParser& operator=(const ParallelParser&) = delete;
+
+        /// <summary>
+        /// Sets the number of bytes scanned by a thread at a time. It is
+        /// rounded up to a multiple of 64.
+        /// </summary>
+        void setChunkSize(size_t bytes);
+
+        /// <returns>The number of bytes in a chunk.</returns>
+        size_t chunkSize() const;
+
+        /// <summary>
+        /// Sets the number of threads to use. Zero uses the OpenMP default.
+        /// </summary>
+        void setThreadCount(U32 threads);
+
+        /// <returns>The requested number of threads.</returns>
+        U32 threadCount() const;
+
+        /// <summary>
+        /// Replaces the contents of the parser with the parsed file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <returns>The new root, or null if the file could not be parsed.</returns>
+        Type* parse(const String& path);
+
+        /// <summary>
+        /// Replaces the contents of the parser with the parsed memory.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <param name="padding">See Parser::parse</param>
+        /// <returns>The new root, or null if the memory could not be parsed.</returns>
+        Type* parse(const char* src, size_t sizeInBytes, size_t padding = 0);
+
+        /// <returns>The root of the last parse, or null if it failed.</returns>
+        /// <remarks>
+        /// The tree is owned by the parser and is valid until it is cleared,
+        /// destroyed or used to parse again.
+        /// </remarks>
+        Type* root() const;
+
+        /// <summary>
+        /// Destroys the parsed tree.
+        /// </summary>
+        void clear();
+    };
+
+    inline void ParallelParser::setChunkSize(const size_t bytes)
+    {
+        _chunkSize = bytes > 64 ? (bytes + 63) & ~(size_t)63 : 64;
+    }
+
+    inline size_t ParallelParser::chunkSize() const
+    {
+        return _chunkSize;
+    }
+
+    inline void ParallelParser::setThreadCount(const U32 threads)
+    {
+        _threads = threads;
+    }
+
+    inline U32 ParallelParser::threadCount() const
+    {
+        return _threads;
+    }
+
+    inline Type* ParallelParser::root() const
+    {
+        return _document.root();
+    }
+}  // namespace Rt2::Json
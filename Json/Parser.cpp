@@ -34,7 +34,9 @@ namespace Rt2::Json
 
     Parser::Parser(Visitor* visitor) :
         _visitor(visitor),
-        _owns(visitor == nullptr)
+        _owns(visitor == nullptr),
+        _maxDepth(DefaultMaxDepth),
+        _elements(false)
     {
         if (_visitor == nullptr)
             _visitor = new MemoryObjectVisitor();
@@ -50,21 +52,30 @@ namespace Rt2::Json
     {
         Token tok;
         scanner.scan(tok);
+        return parse(scanner, tok);
+    }
 
-        Type* root;
-        if (tok.type() == JT_L_BRACKET)
-        {
-            parseObject(scanner, tok);
-            root = _visitor->root();
-        }
-        else if (tok.type() == JT_L_BRACE)
-        {
-            parseArray(scanner, tok);
-            root = _visitor->root();
-        }
-        else
-            root = nullptr;
-        return root;
+    Type* Parser::parse(Scanner& scanner, Token& first)
+    {
+        if (first.type() != JT_L_BRACKET && first.type() != JT_L_BRACE)
+            return nullptr;
+        if (!parseValue(scanner, first))
+            return nullptr;
+        return _visitor->root();
+    }
+
+    Type* Parser::parseElements(Scanner& scanner)
+    {
+        _frames.clear();
+        _keys.clear();
+        _frames.push_back({false, ST_VALUE_OR_END, 0});
+        _visitor->arrayCreated();
+
+        Token tok;
+        _elements         = true;
+        const bool result = run(scanner, tok);
+        _elements         = false;
+        return result ? _visitor->root() : nullptr;
     }
 
     Type* Parser::parse(const String& path)
@@ -86,10 +97,10 @@ namespace Rt2::Json
         return object ? object->asObject() : nullptr;
     }
 
-    Type* Parser::parse(const char* src, const size_t sizeInBytes)
+    Type* Parser::parse(const char* src, const size_t sizeInBytes, const size_t padding)
     {
         Scanner scn;
-        scn.open(src, sizeInBytes);
+        scn.borrow(src, sizeInBytes, padding);
 
         if (!scn.isOpen())
         {
@@ -99,123 +110,220 @@ namespace Rt2::Json
         return parseCommon(scn);
     }
 
-    void Parser::parseObject(Scanner& scn, Token& tok)
+    bool Parser::fail(const Token& tok)
     {
-        _visitor->objectCreated();
-        Token t1, t2;
+        _visitor->parseError(tok);
+        _frames.clear();
+        _keys.clear();
+        return false;
+    }
 
-        while (tok.type() != JT_R_BRACKET)
+    bool Parser::open(const Token& tok, const StringView& key)
+    {
+        if (_frames.size() >= _maxDepth)
         {
-            scn.scan(t1);
+            Console::writeError("maximum nesting depth exceeded");
+            return fail(tok);
+        }
 
-            if (t1.type() == JT_R_BRACKET)
-            {
-                break;  // empty
-            }
+        // The key of a member is only needed again once the nested value
+        // is closed, so keep a copy that is independent of the token.
+        const U32 offset = (U32)_keys.size();
+        _keys.append(key.data(), key.size());
 
-            if (t1.type() != JT_STRING)
-            {
-                _visitor->parseError(t1);
-                return;
-            }
+        const bool object = tok.type() == JT_L_BRACKET;
+        _frames.push_back({object, object ? ST_KEY_OR_END : ST_VALUE_OR_END, offset});
 
-            scn.scan(t2);
-            if (t2.type() != JT_COLON)
-            {
-                _visitor->parseError(t2);
-                return;
-            }
-            scn.scan(t2);
+        if (object)
+            _visitor->objectCreated();
+        else
+            _visitor->arrayCreated();
+        return true;
+    }
 
-            TokenType type = t2.type();
-            switch (type)
-            {
-            case JT_L_BRACE:
-                parseArray(scn, t2);
-                break;
-            case JT_L_BRACKET:
-                parseObject(scn, t2);
-                break;
-            case JT_STRING:
-            case JT_NULL:
-            case JT_BOOL:
-            case JT_NUMBER:
-            case JT_INTEGER:
-                break;
-            case JT_UNDEFINED:
-            case JT_COLON:
-            case JT_COMMA:
-            case JT_R_BRACE:
-            case JT_R_BRACKET:
-                _visitor->parseError(t2);
-                return;
-            }
+    void Parser::close()
+    {
+        const Frame frame = _frames.back();
+        _frames.pop_back();
 
-            _visitor->keyValueParsed(t1.value(), type, t2.value());
+        if (frame.object)
+            _visitor->objectFinished();
+        else
+            _visitor->arrayFinished();
 
-            scn.scan(tok);
-            if (tok.type() == JT_NULL)
+        if (!_frames.empty())
+        {
+            if (_frames.back().object)
             {
-                _visitor->parseError(tok);
-                return;
+                const StringView key(_keys.data() + frame.key, _keys.size() - frame.key);
+                _visitor->keyValueParsed(key, frame.object ? JT_L_BRACKET : JT_L_BRACE, StringView());
             }
+            else if (frame.object)
+                _visitor->objectParsed();
+            else
+                _visitor->arrayParsed();
         }
+        _keys.resize(frame.key);
+    }
 
-        _visitor->objectFinished();
+    bool Parser::value(const Token& tok, const StringView& key)
+    {
+        const TokenType type = tok.type();
+
+        Frame& top = _frames.back();
+        top.state  = ST_COMMA_OR_END;
+
+        switch (type)
+        {
+        case JT_L_BRACKET:
+        case JT_L_BRACE:
+            return open(tok, top.object ? key : StringView());
+        case JT_NULL:
+            if (tok.view().empty())
+                return fail(tok);  // end of input
+            break;
+        case JT_STRING:
+        case JT_BOOL:
+        case JT_NUMBER:
+        case JT_INTEGER:
+            break;
+        case JT_UNDEFINED:
+        case JT_COLON:
+        case JT_COMMA:
+        case JT_R_BRACE:
+        case JT_R_BRACKET:
+            return fail(tok);
+        }
+
+        if (top.object)
+        {
+            if (tok.hasInteger())
+                _visitor->keyIntegerParsed(key, tok.view(), tok.integer());
+            else
+                _visitor->keyValueParsed(key, type, tok.view());
+            return true;
+        }
+
+        switch (type)
+        {
+        case JT_STRING:
+            _visitor->stringParsed(tok.view());
+            break;
+        case JT_NULL:
+            _visitor->pointerParsed(tok.view());
+            break;
+        case JT_BOOL:
+            _visitor->booleanParsed(tok.view());
+            break;
+        case JT_NUMBER:
+            _visitor->doubleParsed(tok.view());
+            break;
+        case JT_INTEGER:
+            if (tok.hasInteger())
+                _visitor->integerValueParsed(tok.view(), tok.integer());
+            else
+                _visitor->integerParsed(tok.view());
+            break;
+        default:
+            break;
+        }
+        return true;
     }
 
-    void Parser::parseArray(Scanner& scn, Token& tok)
+    bool Parser::parseValue(Scanner& scn, Token& tok)
     {
-        _visitor->arrayCreated();
-        Token t1;
+        _frames.clear();
+        _keys.clear();
 
-        while (tok.type() != JT_R_BRACE)
+        if (!open(tok, StringView()))
+            return false;
+        return run(scn, tok);
+    }
+
+    bool Parser::closes(const Token& tok) const
+    {
+        // with parseElements the outermost array ends with the input
+        if (_elements && _frames.size() == 1)
+            return tok.type() == JT_NULL && tok.view().empty();
+        return tok.type() == JT_R_BRACE;
+    }
+
+    bool Parser::run(Scanner& scn, Token& tok)
+    {
+        // The key token is kept apart from tok so that its view is still
+        // valid while the member value is scanned.
+        Token key;
+
+        while (!_frames.empty())
         {
-            scn.scan(t1);
-            if (t1.type() == JT_R_BRACE)
-                break;  // empty
+            const Frame& top = _frames.back();
+            if (top.state == ST_KEY_OR_END)
+            {
+                scn.scan(key);
+                if (key.type() == JT_R_BRACKET)
+                    close();
+                else if (key.type() != JT_STRING)
+                    return fail(key);
+                else
+                {
+                    const VisitAction action = _visitor->keyParsed(key.view());
+                    if (action == VA_STOP)
+                    {
+                        _frames.clear();
+                        _keys.clear();
+                        return false;
+                    }
+                    _frames.back().state = action == VA_SKIP ? ST_SKIP_COLON : ST_COLON;
+                }
+                continue;
+            }
 
-            switch (t1.type())
+            scn.scan(tok);
+            const TokenType type = tok.type();
+
+            switch (top.state)
             {
-            case JT_L_BRACE:
-                parseArray(scn, t1);
-                _visitor->arrayParsed();
+            case ST_COLON:
+                if (type != JT_COLON)
+                    return fail(tok);
+                _frames.back().state = ST_MEMBER;
                 break;
-            case JT_L_BRACKET:
-                parseObject(scn, t1);
-                _visitor->objectParsed();
+            case ST_MEMBER:
+                if (!value(tok, key.view()))
+                    return false;
                 break;
-            case JT_STRING:
-                _visitor->stringParsed(t1.value());
+            case ST_SKIP_COLON:
+                if (type != JT_COLON)
+                    return fail(tok);
+                _frames.back().state = ST_SKIP_MEMBER;
                 break;
-            case JT_NULL:
-                _visitor->pointerParsed(t1.value());
+            case ST_SKIP_MEMBER:
+                if (type == JT_UNDEFINED || type == JT_COLON || type == JT_COMMA ||
+                    type == JT_R_BRACE || type == JT_R_BRACKET ||
+                    (type == JT_NULL && tok.view().empty()))
+                    return fail(tok);
+                if (!scn.skip(tok))
+                    return fail(tok);
+                _frames.back().state = ST_COMMA_OR_END;
                 break;
-            case JT_BOOL:
-                _visitor->booleanParsed(t1.value());
+            case ST_VALUE_OR_END:
+                if (closes(tok))
+                    close();
+                else if (!value(tok, StringView()))
+                    return false;
                 break;
-            case JT_NUMBER:
-                _visitor->doubleParsed(t1.value());
+            case ST_COMMA_OR_END:
+                if (type == JT_COMMA)
+                    _frames.back().state = top.object ? ST_KEY_OR_END : ST_VALUE_OR_END;
+                else if (top.object ? type == JT_R_BRACKET : closes(tok))
+                    close();
+                else
+                    return fail(tok);
                 break;
-            case JT_INTEGER:
-                _visitor->integerParsed(t1.value());
+            case ST_KEY_OR_END:
                 break;
-            case JT_UNDEFINED:
-            case JT_COLON:
-            case JT_COMMA:
-            case JT_R_BRACE:
-            case JT_R_BRACKET:
-                _visitor->parseError(t1);
-                return;
-            }
-
-            scn.scan(tok);
-            if (tok.type() == JT_NULL)
-            {
-                _visitor->parseError(tok);
-                return;
             }
         }
-        _visitor->arrayFinished();
+        return true;
     }
 }  // namespace Rt2::Json
\ No newline at end of file
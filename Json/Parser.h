@@ -23,21 +23,71 @@
 
 #include "Json/Scanner.h"
 #include "Json/Token.h"
+#include "Utils/Array.h"
 
 namespace Rt2::Json
 {
 
     class Visitor;
 
+    /// \ingroup Json
+    ///
+    /// Drives a Visitor over a scanned document.
+    ///
+    /// Nesting is tracked in an explicit stack of frames rather than on the
+    /// call stack, so the amount of thread stack used does not depend on
+    /// the input. Documents nested deeper than maxDepth are rejected.
+    ///
+    /// The visitor is asked about every key before its value is parsed,
+    /// see Visitor::keyParsed. When it skips a member the value is passed
+    /// over, and when it stops the parse returns null.
     class Parser
     {
+    public:
+        /// <summary>
+        /// The default limit on the number of open objects and arrays.
+        /// </summary>
+        static constexpr U32 DefaultMaxDepth = 512;
+
     private:
-        Visitor* _visitor;
-        bool     _owns;
+        enum State
+        {
+            ST_KEY_OR_END,
+            ST_COLON,
+            ST_MEMBER,
+            ST_VALUE_OR_END,
+            ST_COMMA_OR_END,
+            ST_SKIP_COLON,
+            ST_SKIP_MEMBER,
+        };
+
+        struct Frame
+        {
+            bool  object;
+            State state;
+            U32   key;
+        };
+
+        Visitor*     _visitor;
+        bool         _owns;
+        U32          _maxDepth;
+        Array<Frame> _frames;
+        String       _keys;
+        bool         _elements;
+
+        bool parseValue(Scanner& scn, Token& tok);
+
+        bool run(Scanner& scn, Token& tok);
+
+        bool closes(const Token& tok) const;
 
-        void parseObject(Scanner& scn, Token& tok);
+        bool open(const Token& tok, const StringView& key);
 
-        void parseArray(Scanner& scn, Token& tok);
+        void close();
+
+        bool value(const Token& tok, const StringView& key);
+
+        bool fail(const Token& tok);
 
         Type* parseCommon(Scanner& scanner);
 
@@ -45,6 +95,20 @@ namespace Rt2::Json
         explicit Parser(Visitor* visitor = nullptr);
         ~Parser();
 
+        /// <summary>
+        /// Sets the maximum number of objects and arrays that may be open
+        /// at once. Deeper documents fail to parse.
+        /// </summary>
+        /// <remarks>
+        /// Destroying a tree does not recurse, but Type::toString and the
+        /// Printer descend one call per level, so the limit also bounds
+        /// the stack they use on a parsed tree.
+        /// </remarks>
+        void setMaxDepth(U32 depth);
+
+        /// <returns>The maximum nesting depth.</returns>
+        U32 maxDepth() const;
+
         /// <summary>
         /// Attempts to parse the file path as JSON.
         /// </summary>
@@ -78,6 +142,47 @@ namespace Rt2::Json
         /// </summary>
         /// <param name="src">Memory source</param>
         /// <param name="sizeInBytes">The size of the source memory in bytes</param>
-        Type* parse(const char* src, size_t sizeInBytes);
+        /// <param name="padding">
+        /// The number of readable bytes that follow src + sizeInBytes.
+        /// See Scanner::borrow.
+        /// </param>
+        /// <remarks>
+        /// The memory is scanned in place, it is not copied.
+        /// </remarks>
+        Type* parse(const char* src, size_t sizeInBytes, size_t padding = 0);
+
+        /// <summary>
+        /// Parses an object or array whose first token has already been
+        /// read from the scanner.
+        /// </summary>
+        /// <param name="scanner">The scanner that produced first</param>
+        /// <param name="first">The opening bracket or brace</param>
+        /// <returns>The parsed value, or null on error.</returns>
+        /// <remarks>
+        /// The scanner is left on the character that follows the value.
+        /// </remarks>
+        Type* parse(Scanner& scanner, Token& first);
+
+        /// <summary>
+        /// Parses comma separated values as the elements of an array whose
+        /// brackets are not part of the input.
+        /// </summary>
+        /// <param name="scanner">A scanner that is positioned before the first element</param>
+        /// <returns>An array of the values, or null on error.</returns>
+        /// <remarks>
+        /// The end of the input closes the array. This lets a large array be
+        /// split at its top level commas and the parts parsed separately.
+        /// </remarks>
+        Type* parseElements(Scanner& scanner);
     };
+
+    inline void Parser::setMaxDepth(const U32 depth)
+    {
+        _maxDepth = depth;
+    }
+
+    inline U32 Parser::maxDepth() const
+    {
+        return _maxDepth;
+    }
 }  // namespace Rt2::Json
@@ -28,45 +28,25 @@ namespace Rt2::Json
 {
     class PointerType final : public Type
     {
-    private:
-        size_t _address;
-
-        void notifyStringChanged() override
-        {
-            if (_value == "null")
-                _address = 0;
-            else
-                _address = Char::toUint64(_value);
-        }
-
-        void notifyValueChanged() override
-        {
-            if (!_address)
-                _value.assign("null");
-            else
-                Char::toString(_value, _address);
-        }
-
     public:
         PointerType() :
-            Type(POINTER),
-            _address(0)
+            Type(POINTER)
         {
         }
 
         explicit PointerType(const void* vp) :
-            Type(POINTER),
-            _address((size_t)vp)
+            Type(POINTER)
         {
+            _scalar.u64 = (size_t)vp;
             notifyValueChanged();
         }
 
         void toString(StringBuilder& dest) override
         {
-            if (!_address)
+            if (!_scalar.u64)
                 dest.write("null");
             else
-                dest.write(_address);
+                dest.write(_scalar.u64);
         }
     };
 }  // namespace Rt2::Json
@@ -25,6 +25,7 @@
 #include "Type.h"
 #include "ArrayType.h"
 #include "ObjectType.h"
+#include "StringType.h"
 
 namespace Rt2::Json
 {
@@ -69,9 +70,7 @@ namespace Rt2::Json
                     first = false;
 
                 writeSpace();
-                _buffer.write('"');
-                _buffer.write(it.first);
-                _buffer.write('"');
+                StringType::writeQuoted(_buffer, it.first);
                 _buffer.write(':');
                 _buffer.write(' ');
 
@@ -0,0 +1,369 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Json/Projection.h"
+#include "Json/ArrayType.h"
+#include "Json/BoolType.h"
+#include "Json/DoubleType.h"
+#include "Json/IntegerType.h"
+#include "Json/MemoryObjectVisitor.h"
+#include "Json/ObjectType.h"
+#include "Json/Parser.h"
+#include "Json/PointerType.h"
+#include "Json/Scanner.h"
+#include "Json/StringType.h"
+#include "Utils/Console.h"
+
+namespace Rt2::Json
+{
+    namespace
+    {
+        // RFC 6901 array indices are decimal without leading zeros.
+        U32 toIndex(const String& token)
+        {
+            if (token.empty() || token.size() > 9 || (token.size() > 1 && token[0] == '0'))
+                return 0xFFFFFFFF;
+
+            U32 index = 0;
+            for (const char ch : token)
+            {
+                if (ch < '0' || ch > '9')
+                    return 0xFFFFFFFF;
+                index = index * 10 + (U32)(ch - '0');
+            }
+            return index;
+        }
+    }  // namespace
+
+    Projection::Projection() :
+        _remaining(0)
+    {
+        clear();
+    }
+
+    void Projection::clear()
+    {
+        _nodes.clear();
+        _results.clear();
+        _resolved.clear();
+        _frames.clear();
+        _document.clear();
+        _nodes.push_back({String(), None, None, None, 0});
+        _remaining = 0;
+    }
+
+    U32 Projection::child(const U32 node, const StringView& name) const
+    {
+        if (_nodes[node].children == 0)
+            return None;
+
+        for (U32 i = node + 1; i < _nodes.size(); ++i)
+        {
+            if (const Node& cur = _nodes[i];
+                cur.parent == node && StringView(cur.name) == name)
+                return i;
+        }
+        return None;
+    }
+
+    U32 Projection::child(const U32 node, const U32 index) const
+    {
+        if (_nodes[node].children == 0)
+            return None;
+
+        for (U32 i = node + 1; i < _nodes.size(); ++i)
+        {
+            if (const Node& cur = _nodes[i];
+                cur.parent == node && cur.index == index)
+                return i;
+        }
+        return None;
+    }
+
+    size_t Projection::add(const String& pointer)
+    {
+        if (!pointer.empty() && pointer[0] != '/')
+            return Npos;
+
+        U32    node = 0;
+        size_t pos  = 0;
+        while (pos < pointer.size())
+        {
+            // pos is on the '/' that starts a reference token
+            String name;
+            for (++pos; pos < pointer.size() && pointer[pos] != '/'; ++pos)
+            {
+                char ch = pointer[pos];
+                if (ch == '~')
+                {
+                    if (++pos >= pointer.size())
+                        return Npos;
+                    if (pointer[pos] == '0')
+                        ch = '~';
+                    else if (pointer[pos] == '1')
+                        ch = '/';
+                    else
+                        return Npos;
+                }
+                name.push_back(ch);
+            }
+
+            U32 next = child(node, StringView(name));
+            if (next == None)
+            {
+                next = _nodes.size();
+                _nodes[node].children++;
+                _nodes.push_back({name, node, toIndex(name), None, 0});
+            }
+            node = next;
+        }
+
+        if (_nodes[node].result == None)
+        {
+            _nodes[node].result = _results.size();
+            _results.push_back(nullptr);
+            _resolved.push_back(0);
+        }
+        return _nodes[node].result;
+    }
+
+    bool Projection::parse(const String& path)
+    {
+        Scanner scn;
+        scn.open(path);
+
+        if (!scn.isOpen())
+        {
+            Console::writeError("failed to open the supplied file: ", path.c_str());
+            return false;
+        }
+        return walk(scn);
+    }
+
+    bool Projection::parse(const char* src, const size_t sizeInBytes, const size_t padding)
+    {
+        Scanner scn;
+        scn.borrow(src, sizeInBytes, padding);
+
+        if (!scn.isOpen())
+        {
+            Console::writeError("failed to open the supplied memory file");
+            return false;
+        }
+        return walk(scn);
+    }
+
+    void Projection::found(const U32 node, Type* value)
+    {
+        const Node& cur = _nodes[node];
+        // a path under a built value is settled even when the value lacks it
+        if (cur.result != None && !_resolved[cur.result])
+        {
+            _results[cur.result]  = value;
+            _resolved[cur.result] = 1;
+            --_remaining;
+        }
+
+        // deeper paths are inside the value that was just built
+        for (U32 i = node + 1; i < _nodes.size() && cur.children > 0; ++i)
+        {
+            const Node& sub = _nodes[i];
+            if (sub.parent != node)
+                continue;
+
+            Type* element = nullptr;
+            if (value && value->isObject())
+                element = value->asObject()->find(sub.name);
+            else if (value && value->isArray() && sub.index != None)
+                element = value->asArray()->at(sub.index);
+            found(i, element);
+        }
+    }
+
+    Type* Projection::build(Scanner& scn, Token& tok)
+    {
+        Type* value = nullptr;
+        switch (tok.type())
+        {
+        case JT_L_BRACE:
+        case JT_L_BRACKET:
+        {
+            MemoryObjectVisitor visitor(&_document);
+            Parser              parser(&visitor);
+            return parser.parse(scn, tok);
+        }
+        case JT_STRING:
+            value = _document.create<StringType>();
+            break;
+        case JT_NULL:
+            value = _document.create<PointerType>();
+            break;
+        case JT_BOOL:
+            value = _document.create<BoolType>();
+            break;
+        case JT_NUMBER:
+            value = _document.create<DoubleType>();
+            break;
+        case JT_INTEGER:
+            if (tok.hasInteger())
+                return _document.create<IntegerType>(tok.integer());
+            value = _document.create<IntegerType>();
+            break;
+        default:
+            return nullptr;
+        }
+        value->setValue(tok.view());
+        return value;
+    }
+
+    bool Projection::value(Scanner& scn, Token& tok, const U32 node)
+    {
+        const TokenType type = tok.type();
+        switch (type)
+        {
+        case JT_NULL:
+            if (tok.view().empty())
+                return false;  // end of input
+            break;
+        case JT_UNDEFINED:
+        case JT_COLON:
+        case JT_COMMA:
+        case JT_R_BRACE:
+        case JT_R_BRACKET:
+            return false;
+        default:
+            break;
+        }
+
+        const bool container = type == JT_L_BRACE || type == JT_L_BRACKET;
+
+        // Unrequested values are skipped, as are repeated keys.
+        if (node == None ||
+            (_nodes[node].result != None && _resolved[_nodes[node].result]))
+            return scn.skip(tok);
+
+        if (_nodes[node].result != None)
+        {
+            Type* built = build(scn, tok);
+            if (!built)
+                return false;
+            found(node, built);
+            return true;
+        }
+
+        if (container)
+        {
+            const bool object = type == JT_L_BRACKET;
+            _frames.push_back({object, object ? ST_KEY_OR_END : ST_VALUE_OR_END, node, 0});
+        }
+        return true;
+    }
+
+    bool Projection::fail(const Token& tok)
+    {
+        Console::writeError("Parse error: ", tok.value().c_str());
+        for (U32 i = 0; i < _results.size(); ++i)
+        {
+            _results[i]  = nullptr;
+            _resolved[i] = 0;
+        }
+        _frames.clear();
+        _document.clear();
+        return false;
+    }
+
+    bool Projection::walk(Scanner& scn)
+    {
+        _document.clear();
+        _frames.clear();
+        for (U32 i = 0; i < _results.size(); ++i)
+        {
+            _results[i]  = nullptr;
+            _resolved[i] = 0;
+        }
+        _remaining = _results.size();
+
+        Token tok, key;
+        scn.scan(tok);
+        if (tok.type() != JT_L_BRACKET && tok.type() != JT_L_BRACE)
+            return fail(tok);
+        if (!value(scn, tok, 0))
+            return fail(tok);
+
+        while (!_frames.empty() && _remaining > 0)
+        {
+            Frame& top = _frames.back();
+            if (top.state == ST_KEY_OR_END)
+            {
+                scn.scan(key);
+                if (key.type() == JT_R_BRACKET)
+                    _frames.pop_back();
+                else if (key.type() == JT_STRING)
+                    top.state = ST_COLON;
+                else
+                    return fail(key);
+                continue;
+            }
+
+            scn.scan(tok);
+            const TokenType type = tok.type();
+
+            switch (top.state)
+            {
+            case ST_COLON:
+                if (type != JT_COLON)
+                    return fail(tok);
+                top.state = ST_MEMBER;
+                break;
+            case ST_MEMBER:
+            {
+                top.state       = ST_COMMA_OR_END;
+                const U32 match = child(top.node, key.view());
+                if (!value(scn, tok, match))
+                    return fail(tok);
+                break;
+            }
+            case ST_VALUE_OR_END:
+                if (type == JT_R_BRACE)
+                    _frames.pop_back();
+                else
+                {
+                    top.state       = ST_COMMA_OR_END;
+                    const U32 match = child(top.node, top.count++);
+                    if (!value(scn, tok, match))
+                        return fail(tok);
+                }
+                break;
+            case ST_COMMA_OR_END:
+                if (type == JT_COMMA)
+                    top.state = top.object ? ST_KEY_OR_END : ST_VALUE_OR_END;
+                else if (type == (top.object ? JT_R_BRACKET : JT_R_BRACE))
+                    _frames.pop_back();
+                else
+                    return fail(tok);
+                break;
+            case ST_KEY_OR_END:
+                break;
+            }
+        }
+        return true;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,164 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Document.h"
+#include "Json/Token.h"
+#include "Utils/Array.h"
+#include "Utils/String.h"
+
+namespace Rt2::Json
+{
+    class Scanner;
+
+    /// \ingroup Json
+    ///
+    /// Extracts a few values from a large document.
+    ///
+    /// The wanted values are named with JSON pointers (RFC 6901), for
+    /// example "/user/name" or "/items/0/id". While parsing, only the
+    /// containers along those paths are followed and only the values they
+    /// name are built. Every other object or array is passed over by
+    /// Scanner::skip without being tokenized. Scanning stops as soon as
+    /// every path has been found, so the rest of the input is not checked.
+    ///
+    /// <code>
+    /// Projection proj;
+    /// const size_t name = proj.add("/user/name");
+    /// if (proj.parse(src, len))
+    ///     proj.at(name)->string();
+    /// </code>
+    class Projection
+    {
+    private:
+        static constexpr U32 None = 0xFFFFFFFF;
+
+        /// One reference token of a pointer. Node 0 is the document root.
+        struct Node
+        {
+            String name;
+            U32    parent;
+            U32    index;
+            U32    result;
+            U32    children;
+        };
+
+        enum State
+        {
+            ST_KEY_OR_END,
+            ST_COLON,
+            ST_MEMBER,
+            ST_VALUE_OR_END,
+            ST_COMMA_OR_END,
+        };
+
+        struct Frame
+        {
+            bool  object;
+            State state;
+            U32   node;
+            U32   count;
+        };
+
+        Array<Node>  _nodes;
+        Array<Type*> _results;
+        Array<U8>    _resolved;
+        Array<Frame> _frames;
+        Document     _document;
+        U32          _remaining;
+
+        U32 child(U32 node, const StringView& name) const;
+
+        U32 child(U32 node, U32 index) const;
+
+        bool walk(Scanner& scn);
+
+        bool value(Scanner& scn, Token& tok, U32 node);
+
+        Type* build(Scanner& scn, Token& tok);
+
+        void found(U32 node, Type* value);
+
+        bool fail(const Token& tok);
+
+    public:
+        Projection();
+
+        Projection(const Projection&)            = delete;
+        Projection& operator=(const Projection&) = delete;
+
+        /// <summary>
+        /// Requests the value at the supplied JSON pointer.
+        /// </summary>
+        /// <param name="pointer">
+        /// An RFC 6901 pointer. The empty string names the whole document.
+        /// </param>
+        /// <returns>
+        /// The index to pass to at, or Npos if the pointer is malformed.
+        /// </returns>
+        size_t add(const String& pointer);
+
+        /// <returns>The number of requested paths.</returns>
+        size_t size() const;
+
+        /// <summary>
+        /// Extracts the requested values from the supplied file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <returns>false if the file could not be read or is not valid json.</returns>
+        bool parse(const String& path);
+
+        /// <summary>
+        /// Extracts the requested values from the supplied memory.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <param name="padding">See Parser::parse</param>
+        /// <returns>false if the memory is not valid json.</returns>
+        bool parse(const char* src, size_t sizeInBytes, size_t padding = 0);
+
+        /// <summary>
+        /// Returns the value found for a requested path.
+        /// </summary>
+        /// <param name="i">An index that was returned by add.</param>
+        /// <returns>
+        /// The value, or null if the path is not in the document. The value
+        /// is owned by the projection and is valid until the next parse.
+        /// </returns>
+        Type* at(size_t i) const;
+
+        /// <summary>
+        /// Removes every requested path and value.
+        /// </summary>
+        void clear();
+    };
+
+    inline size_t Projection::size() const
+    {
+        return _results.size();
+    }
+
+    inline Type* Projection::at(const size_t i) const
+    {
+        return i < _results.size() ? _results.at((U32)i) : nullptr;
+    }
+}  // namespace Rt2::Json
@@ -20,6 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #include "Scanner.h"
+#include "Number.h"
 #include "Utils/Char.h"
 
 namespace Rt2::Json
@@ -27,51 +28,88 @@ namespace Rt2::Json
     Scanner::Scanner() :
         _data(nullptr),
         _len(Npos),
-        _pos(Npos)
+        _pos(Npos),
+        _buffer(nullptr),
+        _padded(false),
+        _indexed(false),
+        _indexThreshold(IndexThreshold),
+        _findString(Simd::stringScanner()),
+        _classify(Simd::classifier())
     {
     }
 
     Scanner::~Scanner()
     {
-        delete[] _data;
-        _data = nullptr;
+        close();
+    }
+
+    void Scanner::close()
+    {
+        delete[] _buffer;
+        _buffer = nullptr;
+        _file.close();
+
+        _data    = nullptr;
+        _len     = Npos;
+        _pos     = Npos;
+        _padded  = false;
+        _indexed = false;
+    }
+
+    void Scanner::opened()
+    {
+        _indexed = _len >= _indexThreshold;
+        if (_indexed)
+            _index.reset(_data, _len);
+    }
+
+    void Scanner::setIndexThreshold(const size_t len)
+    {
+        _indexThreshold = len;
     }
 
     void Scanner::open(const String& path)
     {
-        if (InputFileStream fs =
-                InputFileStream(path.c_str(),
-                                std::ios::ate | std::ios::binary); fs.is_open())
+        close();
+
+        if (_file.open(path))
         {
-            if (const std::streamsize len = fs.tellg();
-                len > 0 && len < Npos16)
-            {
-                fs.seekg(0, std::ios::beg);
-                _len = len;
-                _pos = 0;
-                delete[] _data;
-                _data = nullptr;
-
-                _data = new char[_len + 1];
-                fs.read(_data, _len);
-                _data[_len] = 0;
-            }
+            _data = _file.data();
+            _len  = _file.size();
+            _pos  = 0;
+            opened();
         }
     }
 
     void Scanner::open(const char* mem, const size_t len)
     {
-        if (mem && len > 0 && len < Npos16)
+        close();
+
+        if (mem && len > 0 && len < Npos - Padding)
         {
             _len = len;
             _pos = 0;
 
-            delete[] _data;
-            _data = nullptr;
+            _buffer = new char[_len + Padding];
+            memcpy(_buffer, mem, len);
+            memset(_buffer + _len, 0, Padding);
+            _data   = _buffer;
+            _padded = true;
+            opened();
+        }
+    }
+
+    void Scanner::borrow(const char* mem, const size_t len, const size_t padding)
+    {
+        close();
 
-            _data = new char[_len + 1];
-            memcpy(_data, mem, len);
-            _data[_len] = 0;
+        if (mem && len > 0 && len != Npos)
+        {
+            _data   = mem;
+            _len    = len;
+            _pos    = 0;
+            _padded = padding >= Padding;
+            opened();
         }
     }
 
@@ -84,6 +122,14 @@ namespace Rt2::Json
 
         while (_pos < _len)
         {
+            if (_indexed)
+            {
+                if (const size_t next = _index.next(_pos); next == Npos)
+                    _indexed = false;  // a comment, scan the rest byte by byte
+                else if ((_pos = next) >= _len)
+                    break;
+            }
+
             char ch = _data[_pos];
             ++_pos;
 
@@ -91,15 +137,12 @@ namespace Rt2::Json
             {
             case '/':
             {
-                ch = _data[_pos];
-                if (ch == '/')
+                if (_pos < _len && _data[_pos] == '/')
                 {
-                    while (ch != '\n' && ch != '\r' && ch != 0)
-                    {
+                    while (_pos < _len && _data[_pos] != '\n' && _data[_pos] != '\r')
                         ++_pos;
-                        ch = _data[_pos];
-                    }
-                    if (ch == 0)
+
+                    if (_pos >= _len)
                     {
                         _pos = Npos;
                         return;
@@ -132,19 +175,8 @@ namespace Rt2::Json
                 tok.setType(JT_R_BRACKET);
                 return;
             case '\"':
-            {
-                while (_data[_pos] != '\"' && _data[_pos] != 0)
-                    tok.push(_data[_pos++]);
-
-                if (_data[_pos] == '\"')
-                {
-                    ++_pos;
-                    tok.setType(JT_STRING);
-                    return;
-                }
-                _pos = Npos;
+                scanString(tok);
                 return;
-            }
             case '-':
             case '0':
             case '1':
@@ -157,53 +189,56 @@ namespace Rt2::Json
             case '8':
             case '9':
             {
-                bool hasDot = false;
-                tok.push(ch);
-                for (; _pos < _len; ++_pos)
+                const size_t start = _pos - 1;
+
+                // the digits are accumulated while they are validated
+                const char*     cur = &_data[start];
+                Number::Decimal dec;
+                if (!Number::scan(cur, _data + _len, dec))
                 {
-                    ch = _data[_pos];
-                    if (ch == '.')
-                        hasDot = true;
-                    if (isDigitSet(ch) && ch != 0)
-                        tok.push(ch);
-                    else
-                        break;
+                    _pos = Npos;
+                    return;
                 }
 
-                if (ch != 0)
+                _pos = (size_t)(cur - _data);
+                if (_pos < _len && !isDelimiter(_data[_pos]))
                 {
-                    tok.setType(hasDot ? JT_NUMBER
-                                       : JT_INTEGER);
+                    _pos = Npos;
                     return;
                 }
-                _pos = Npos;
+                tok.setSpan(&_data[start], _pos - start);
+                tok.setType(dec.integer ? JT_INTEGER
+                                        : JT_NUMBER);
+
+                if (I64 integer; Number::toInt64(dec, integer))
+                    tok.setInteger(integer);
                 return;
             }
             case 't':
             case 'f':
             case 'n':
             {
-                if (Char::equals((const char*)&_data[_pos - 1], "true", 4))
+                if (matches("true", 4))
                 {
-                    _pos += 3;
+                    tok.setSpan(&_data[_pos - 1], 4);
                     tok.setType(JT_BOOL);
-                    tok.push("true");
+                    _pos += 3;
                     return;
                 }
 
-                if (Char::equals((const char*)&_data[_pos - 1], "false", 5) )
+                if (matches("false", 5))
                 {
-                    _pos += 4;
+                    tok.setSpan(&_data[_pos - 1], 5);
                     tok.setType(JT_BOOL);
-                    tok.push("false");
+                    _pos += 4;
                     return;
                 }
 
-                if (Char::equals((const char*)&_data[_pos - 1], "null", 4))
+                if (matches("null", 4))
                 {
-                    _pos += 3;
+                    tok.setSpan(&_data[_pos - 1], 4);
                     tok.setType(JT_NULL);
-                    tok.push("null");
+                    _pos += 3;
                     return;
                 }
                 _pos = Npos;
@@ -221,9 +256,336 @@ namespace Rt2::Json
         }
     }
 
-    bool Scanner::isDigitSet(const char ch)
+    bool Scanner::skipString()
+    {
+        // _pos is the first character after the opening quote
+        const char* cur   = _data + _pos;
+        const char* end   = _data + _len;
+        const char* limit = _padded ? end + Padding : end;
+
+        while (cur < end)
+        {
+            cur = _findString(cur, end, limit);
+            if (cur >= end)
+                break;
+
+            if (*cur == '\"')
+            {
+                _pos = (size_t)(cur - _data) + 1;
+                return true;
+            }
+            // control characters are not checked while skipping
+            cur += *cur == '\\' ? 2 : 1;
+        }
+        return false;
+    }
+
+    bool Scanner::skipBlocks(size_t& depth)
+    {
+        // Brackets are counted 64 bytes at a time with the same quote and
+        // escape masks that StructuralIndex uses. The bytes that remain
+        // after the last whole block are left for the caller.
+        U64 escaped  = 0;
+        U64 inString = 0;
+
+        while (_len - _pos >= 64)
+        {
+            BlockMasks masks;
+            _classify(_data + _pos, masks);
+
+            U64       carry = escaped;
+            const U64 quote = masks.quote & ~StructuralIndex::findEscaped(masks.backslash, carry);
+            const U64 body  = StructuralIndex::prefixXor(quote) ^ inString;
+
+            if (masks.slash & ~body)
+                break;  // a comment, the caller scans this block byte by byte
+
+            U64 bits = masks.op & ~body;
+            while (bits)
+            {
+                const U32  idx = Simd::lowestBit(bits);
+                const char ch  = (char)(_data[_pos + idx] | 0x20);
+
+                // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+                if (ch == '{')
+                    ++depth;
+                else if (ch == '}' && --depth == 0)
+                {
+                    _pos += idx + 1;
+                    return true;
+                }
+                bits &= bits - 1;
+            }
+
+            escaped  = carry;
+            inString = (U64)((I64)body >> 63);
+            _pos += 64;
+        }
+
+        if (inString)
+        {
+            // finish the string that the last block ended in
+            if (escaped)
+                ++_pos;
+            if (!skipString())
+                _pos = Npos;
+        }
+        return false;
+    }
+
+    bool Scanner::skip(const Token& tok)
+    {
+        if (tok.type() != JT_L_BRACE && tok.type() != JT_L_BRACKET)
+            return tok.type() != JT_UNDEFINED;
+        if (!isOpen())
+            return false;
+
+        size_t depth = 1;
+        if (!_indexed && skipBlocks(depth))
+            return true;
+
+        while (_pos < _len)
+        {
+            if (_indexed)
+            {
+                if (const size_t next = _index.next(_pos); next == Npos)
+                    _indexed = false;  // a comment, scan the rest byte by byte
+                else if ((_pos = next) >= _len)
+                    break;
+            }
+
+            switch (_data[_pos++])
+            {
+            case '"':
+                if (!skipString())
+                {
+                    _pos = Npos;
+                    return false;
+                }
+                break;
+            case '/':
+                if (_pos < _len && _data[_pos] == '/')
+                {
+                    while (_pos < _len && _data[_pos] != '\n' && _data[_pos] != '\r')
+                        ++_pos;
+                }
+                else
+                {
+                    _pos = Npos;
+                    return false;
+                }
+                break;
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0)
+                    return true;
+                break;
+            default:
+                break;
+            }
+        }
+
+        _pos = Npos;
+        return false;
+    }
+
+    void Scanner::scanString(Token& tok)
+    {
+        // _pos is the first character after the opening quote
+        const char* start = _data + _pos;
+        const char* end   = _data + _len;
+        const char* stop  = _findString(start, end, _padded ? end + Padding : end);
+
+        if (stop < end && *stop == '\"')
+        {
+            tok.setSpan(start, (size_t)(stop - start));
+            tok.setType(JT_STRING);
+            _pos = (size_t)(stop - _data) + 1;
+        }
+        else if (stop < end && *stop == '\\')
+        {
+            tok.push(StringView(start, (size_t)(stop - start)));
+            _pos = (size_t)(stop - _data);
+            scanEscapedString(tok);
+        }
+        else
+        {
+            // unterminated, or a control character that must be escaped
+            _pos = Npos;
+        }
+    }
+
+    void Scanner::scanEscapedString(Token& tok)
+    {
+        // _pos is on a backslash, and everything before it has been pushed
+        const char* end   = _data + _len;
+        const char* limit = _padded ? end + Padding : end;
+
+        while (_pos < _len)
+        {
+            if (_data[_pos] != '\\')
+            {
+                const char* run  = _data + _pos;
+                const char* stop = _findString(run, end, limit);
+                if (stop == end || (U8)*stop < 0x20)
+                    break;
+
+                tok.push(StringView(run, (size_t)(stop - run)));
+                _pos = (size_t)(stop - _data);
+
+                if (*stop == '\"')
+                {
+                    tok.setType(JT_STRING);
+                    ++_pos;
+                    return;
+                }
+            }
+
+            if (++_pos >= _len)
+                break;
+
+            switch (_data[_pos++])
+            {
+            case '\"':
+                tok.push('\"');
+                break;
+            case '\\':
+                tok.push('\\');
+                break;
+            case '/':
+                tok.push('/');
+                break;
+            case 'b':
+                tok.push('\b');
+                break;
+            case 'f':
+                tok.push('\f');
+                break;
+            case 'n':
+                tok.push('\n');
+                break;
+            case 'r':
+                tok.push('\r');
+                break;
+            case 't':
+                tok.push('\t');
+                break;
+            case 'u':
+                if (!scanUnicode(tok))
+                {
+                    _pos = Npos;
+                    return;
+                }
+                break;
+            default:
+                _pos = Npos;
+                return;
+            }
+        }
+        _pos = Npos;
+    }
+
+    bool Scanner::scanUnicode(Token& tok)
     {
-        return ch >= '0' && ch <= '9' || ch == '-' || ch == '.';
+        // _pos is the first character after \u
+        U32 cp = scanHex();
+        if (cp == Npos32)
+            return false;
+
+        if (cp >= 0xD800 && cp <= 0xDBFF)
+        {
+            // a high surrogate must be followed by an escaped low surrogate
+            if (_pos + 2 > _len || _data[_pos] != '\\' || _data[_pos + 1] != 'u')
+                return false;
+            _pos += 2;
+
+            const U32 lo = scanHex();
+            if (lo < 0xDC00 || lo > 0xDFFF)
+                return false;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+        }
+        else if (cp >= 0xDC00 && cp <= 0xDFFF)
+            return false;
+
+        if (cp < 0x80)
+            tok.push((char)cp);
+        else if (cp < 0x800)
+        {
+            tok.push((char)(0xC0 | cp >> 6));
+            tok.push((char)(0x80 | (cp & 0x3F)));
+        }
+        else if (cp < 0x10000)
+        {
+            tok.push((char)(0xE0 | cp >> 12));
+            tok.push((char)(0x80 | (cp >> 6 & 0x3F)));
+            tok.push((char)(0x80 | (cp & 0x3F)));
+        }
+        else
+        {
+            tok.push((char)(0xF0 | cp >> 18));
+            tok.push((char)(0x80 | (cp >> 12 & 0x3F)));
+            tok.push((char)(0x80 | (cp >> 6 & 0x3F)));
+            tok.push((char)(0x80 | (cp & 0x3F)));
+        }
+        return true;
     }
 
+    U32 Scanner::scanHex()
+    {
+        if (_pos + 4 > _len)
+            return Npos32;
+
+        U32 value = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const char ch = _data[_pos++];
+            value <<= 4;
+            if (ch >= '0' && ch <= '9')
+                value |= (U32)(ch - '0');
+            else if (ch >= 'a' && ch <= 'f')
+                value |= (U32)(ch - 'a' + 10);
+            else if (ch >= 'A' && ch <= 'F')
+                value |= (U32)(ch - 'A' + 10);
+            else
+                return Npos32;
+        }
+        return value;
+    }
+
+    bool Scanner::matches(const char* word, const size_t len) const
+    {
+        // _pos has already moved past the first character
+        const size_t end = _pos - 1 + len;
+        return end <= _len &&
+               Char::equals(&_data[_pos - 1], word, len) &&
+               (end == _len || isDelimiter(_data[end]));
+    }
+
+    bool Scanner::isDelimiter(const char ch)
+    {
+        switch (ch)
+        {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+        case '"':
+        case '/':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+
 }  // namespace Rt2::Json
\ No newline at end of file
@@ -23,6 +23,8 @@
 
 #include "Utils/Definitions.h"
 #include "Utils/String.h"
+#include "Json/MappedFile.h"
+#include "Json/StructuralIndex.h"
 #include "Json/Token.h"
 
 namespace Rt2::Json
@@ -30,35 +32,123 @@ namespace Rt2::Json
 
     class Scanner
     {
+    public:
+        /// <summary>
+        /// The number of readable bytes past the end of the input that
+        /// lets the scanner skip bounds checks on lookahead.
+        /// </summary>
+        static constexpr size_t Padding = 32;
+
+        /// <summary>
+        /// The default input length where the scanner starts using a
+        /// StructuralIndex to move between tokens.
+        /// </summary>
+        static constexpr size_t IndexThreshold = 0x1000;
+
     private:
-        char*  _data;
-        size_t _len;
-        size_t _pos;
+        const char*     _data;
+        size_t          _len;
+        size_t          _pos;
+        char*           _buffer;
+        MappedFile      _file;
+        bool            _padded;
+        bool            _indexed;
+        size_t          _indexThreshold;
+        StructuralIndex _index;
+
+        Simd::StringFunction   _findString;
+        Simd::ClassifyFunction _classify;
+
+        void opened();
+
+        bool matches(const char* word, size_t len) const;
+
+        void scanString(Token& tok);
+
+        bool skipString();
+
+        bool skipBlocks(size_t& depth);
+
+        void scanEscapedString(Token& tok);
 
-        static bool isDigitSet(char ch);
+        bool scanUnicode(Token& tok);
+
+        U32 scanHex();
+
+        void close();
 
     public:
         Scanner();
         ~Scanner();
 
         /// <summary>
-        ///
+        /// Opens the supplied file for scanning.
         /// </summary>
-        /// <param name="path">const String&</param>
+        /// <param name="path">File system path</param>
+        /// <remarks>
+        /// The file is memory mapped with a sequential access hint, and
+        /// is read into memory when mapping is not possible.
+        /// There is no upper limit on the size of the file.
+        /// </remarks>
         void open(const String& path);
         /// <summary>
-        ///
+        /// Copies the supplied memory into an internal buffer for scanning.
         /// </summary>
-        /// <param name="mem">const char*</param>
-        /// <param name="len">size_t</param>
+        /// <param name="mem">Memory source</param>
+        /// <param name="len">The size of the source memory in bytes</param>
         void open(const char* mem, size_t len);
 
+        /// <summary>
+        /// Scans the supplied memory in place without copying it.
+        /// </summary>
+        /// <param name="mem">Memory source</param>
+        /// <param name="len">The size of the source memory in bytes</param>
+        /// <param name="padding">
+        /// The number of bytes past mem + len that are safe to read.
+        /// Supplying at least Scanner::Padding bytes enables unchecked
+        /// lookahead. The contents of the padding are never interpreted.
+        /// </param>
+        /// <remarks>
+        /// The memory must remain valid and unchanged until the scanner is
+        /// closed or reopened.
+        /// </remarks>
+        void borrow(const char* mem, size_t len, size_t padding = 0);
+
+        /// <summary>
+        /// Sets the input length where the scanner starts jumping between
+        /// tokens with a StructuralIndex instead of stepping over every byte.
+        /// </summary>
+        /// <param name="len">
+        /// The minimum length. Zero always indexes, Npos never indexes.
+        /// </param>
+        /// <remarks>
+        /// The threshold applies to inputs opened after this call.
+        /// </remarks>
+        void setIndexThreshold(size_t len);
+
         /// <summary>
         ///
         /// </summary>
         /// <param name="tok">skJsonToken&</param>
         void scan(Token& tok);
 
+        /// <summary>
+        /// Moves past the rest of the value that starts with the supplied token.
+        /// </summary>
+        /// <param name="tok">The token that was just scanned.</param>
+        /// <returns>false if the input ends before the value does.</returns>
+        /// <remarks>
+        /// An object or array is skipped without producing tokens. Only
+        /// strings and brackets are looked at, so the skipped bytes are not
+        /// otherwise validated. Any other token is already complete.
+        /// </remarks>
+        bool skip(const Token& tok);
+
+        /// <returns>
+        /// true if the character may follow a number or literal.
+        /// </returns>
+        static bool isDelimiter(char ch);
+
         /// <summary>
         ///
         /// </summary>
@@ -0,0 +1,399 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Simd.h"
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+    #define JSON_SSE2
+    #include <emmintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define JSON_AVX2
+        #define JSON_TARGET_AVX2
+        #include <immintrin.h>
+        #include <intrin.h>
+    #elif defined(__GNUC__)
+        #define JSON_AVX2
+        #define JSON_TARGET_AVX2 __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define JSON_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace Rt2::Json
+{
+    static void classifyScalar(const char* block, BlockMasks& dest)
+    {
+        dest = {};
+        for (U64 i = 0; i < 64; ++i)
+        {
+            const U64 bit = (U64)1 << i;
+            switch (block[i])
+            {
+            case '"':
+                dest.quote |= bit;
+                break;
+            case '\\':
+                dest.backslash |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                dest.space |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                dest.op |= bit;
+                break;
+            case '/':
+                dest.slash |= bit;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    static const char* findStringScalar(const char* first, const char* last, const char*)
+    {
+        while (first < last && *first != '"' && *first != '\\' && (U8)*first >= 0x20)
+            ++first;
+        return first;
+    }
+
+#ifdef JSON_SSE2
+    static void classifySse2(const char* block, BlockMasks& dest)
+    {
+        const __m128i quote     = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i space     = _mm_set1_epi8(' ');
+        const __m128i tab       = _mm_set1_epi8('\t');
+        const __m128i lf        = _mm_set1_epi8('\n');
+        const __m128i cr        = _mm_set1_epi8('\r');
+        const __m128i lower     = _mm_set1_epi8(0x20);
+        const __m128i lBracket  = _mm_set1_epi8('{');
+        const __m128i rBracket  = _mm_set1_epi8('}');
+        const __m128i colon     = _mm_set1_epi8(':');
+        const __m128i comma     = _mm_set1_epi8(',');
+        const __m128i slash     = _mm_set1_epi8('/');
+
+        dest = {};
+        for (int i = 0; i < 4; ++i)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+            const __m128i folded = _mm_or_si128(v, lower);
+
+            const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+            const __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, lBracket), _mm_cmpeq_epi8(folded, rBracket)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+
+            const int shift = 16 * i;
+            dest.quote |= (U64)(U16)_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)) << shift;
+            dest.backslash |= (U64)(U16)_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)) << shift;
+            dest.space |= (U64)(U16)_mm_movemask_epi8(ws) << shift;
+            dest.op |= (U64)(U16)_mm_movemask_epi8(op) << shift;
+            dest.slash |= (U64)(U16)_mm_movemask_epi8(_mm_cmpeq_epi8(v, slash)) << shift;
+        }
+    }
+#endif
+
+#ifdef JSON_SSE2
+    static const char* findStringSse2(const char* first, const char* last, const char* limit)
+    {
+        const __m128i quote     = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control   = _mm_set1_epi8(0x1F);
+
+        while (first < last && limit - first >= 16)
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)first);
+
+            // min(v, 0x1F) == v when v <= 0x1F as an unsigned byte
+            const __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                              _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+
+            if (const int bits = _mm_movemask_epi8(stop))
+            {
+                first += Simd::lowestBit((U64)bits);
+                return first < last ? first : last;
+            }
+            first += 16;
+        }
+        return findStringScalar(Min(first, last), last, limit);
+    }
+#endif
+
+#ifdef JSON_AVX2
+    JSON_TARGET_AVX2 static const char* findStringAvx2(const char* first, const char* last, const char* limit)
+    {
+        const __m256i quote     = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control   = _mm256_set1_epi8(0x1F);
+
+        while (first < last && limit - first >= 32)
+        {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)first);
+
+            const __m256i stop = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                                 _mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v));
+
+            if (const U32 bits = (U32)_mm256_movemask_epi8(stop))
+            {
+                first += Simd::lowestBit(bits);
+                return first < last ? first : last;
+            }
+            first += 32;
+        }
+        return findStringSse2(Min(first, last), last, limit);
+    }
+
+    JSON_TARGET_AVX2 static void classifyAvx2(const char* block, BlockMasks& dest)
+    {
+        const __m256i quote     = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i space     = _mm256_set1_epi8(' ');
+        const __m256i tab       = _mm256_set1_epi8('\t');
+        const __m256i lf        = _mm256_set1_epi8('\n');
+        const __m256i cr        = _mm256_set1_epi8('\r');
+        const __m256i lower     = _mm256_set1_epi8(0x20);
+        const __m256i lBracket  = _mm256_set1_epi8('{');
+        const __m256i rBracket  = _mm256_set1_epi8('}');
+        const __m256i colon     = _mm256_set1_epi8(':');
+        const __m256i comma     = _mm256_set1_epi8(',');
+        const __m256i slash     = _mm256_set1_epi8('/');
+
+        dest = {};
+        for (int i = 0; i < 2; ++i)
+        {
+            const __m256i v      = _mm256_loadu_si256((const __m256i*)(block + 32 * i));
+            const __m256i folded = _mm256_or_si256(v, lower);
+
+            const __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                               _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+            const __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, lBracket), _mm256_cmpeq_epi8(folded, rBracket)),
+                                               _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+
+            const int shift = 32 * i;
+            dest.quote |= (U64)(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)) << shift;
+            dest.backslash |= (U64)(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)) << shift;
+            dest.space |= (U64)(U32)_mm256_movemask_epi8(ws) << shift;
+            dest.op |= (U64)(U32)_mm256_movemask_epi8(op) << shift;
+            dest.slash |= (U64)(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, slash)) << shift;
+        }
+    }
+
+    static bool hasAvx2()
+    {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // OSXSAVE and AVX, then the OS must save the ymm registers
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+            return false;
+        if ((_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    #else
+        return __builtin_cpu_supports("avx2") != 0;
+    #endif
+    }
+#endif
+
+#ifdef JSON_NEON
+    static U64 toMask(const uint8x16_t a,
+                      const uint8x16_t b,
+                      const uint8x16_t c,
+                      const uint8x16_t d)
+    {
+        const uint8x16_t bits = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+        uint8x16_t sum0 = vpaddq_u8(vandq_u8(a, bits), vandq_u8(b, bits));
+        uint8x16_t sum1 = vpaddq_u8(vandq_u8(c, bits), vandq_u8(d, bits));
+        sum0            = vpaddq_u8(sum0, sum1);
+        sum0            = vpaddq_u8(sum0, sum0);
+        return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+    }
+
+    static const char* findStringNeon(const char* first, const char* last, const char* limit)
+    {
+        const uint8x16_t quote     = vdupq_n_u8('"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        const uint8x16_t control   = vdupq_n_u8(0x20);
+
+        while (first < last && limit - first >= 16)
+        {
+            const uint8x16_t v    = vld1q_u8((const uint8_t*)first);
+            const uint8x16_t stop = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+                                             vcltq_u8(v, control));
+
+            // narrow each byte of the comparison to a nibble of a 64-bit mask
+            const U64 bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(stop), 4)), 0);
+            if (bits)
+            {
+                first += Simd::lowestBit(bits) >> 2;
+                return first < last ? first : last;
+            }
+            first += 16;
+        }
+        return findStringScalar(Min(first, last), last, limit);
+    }
+
+    static void classifyNeon(const char* block, BlockMasks& dest)
+    {
+        const uint8x16_t quote     = vdupq_n_u8('"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        const uint8x16_t space     = vdupq_n_u8(' ');
+        const uint8x16_t tab       = vdupq_n_u8('\t');
+        const uint8x16_t lf        = vdupq_n_u8('\n');
+        const uint8x16_t cr        = vdupq_n_u8('\r');
+        const uint8x16_t lower     = vdupq_n_u8(0x20);
+        const uint8x16_t lBracket  = vdupq_n_u8('{');
+        const uint8x16_t rBracket  = vdupq_n_u8('}');
+        const uint8x16_t colon     = vdupq_n_u8(':');
+        const uint8x16_t comma     = vdupq_n_u8(',');
+        const uint8x16_t slash     = vdupq_n_u8('/');
+
+        uint8x16_t q[4], b[4], w[4], o[4], s[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            const uint8x16_t v      = vld1q_u8((const uint8_t*)(block + 16 * i));
+            const uint8x16_t folded = vorrq_u8(v, lower);
+
+            q[i] = vceqq_u8(v, quote);
+            b[i] = vceqq_u8(v, backslash);
+            w[i] = vorrq_u8(vorrq_u8(vceqq_u8(v, space), vceqq_u8(v, tab)),
+                            vorrq_u8(vceqq_u8(v, lf), vceqq_u8(v, cr)));
+            o[i] = vorrq_u8(vorrq_u8(vceqq_u8(folded, lBracket), vceqq_u8(folded, rBracket)),
+                            vorrq_u8(vceqq_u8(v, colon), vceqq_u8(v, comma)));
+            s[i] = vceqq_u8(v, slash);
+        }
+
+        dest.quote     = toMask(q[0], q[1], q[2], q[3]);
+        dest.backslash = toMask(b[0], b[1], b[2], b[3]);
+        dest.space     = toMask(w[0], w[1], w[2], w[3]);
+        dest.op        = toMask(o[0], o[1], o[2], o[3]);
+        dest.slash     = toMask(s[0], s[1], s[2], s[3]);
+    }
+#endif
+
+    Simd::Kernel Simd::kernel()
+    {
+        static const Kernel Selected = []
+        {
+            if (supports(AVX2))
+                return AVX2;
+            if (supports(SSE2))
+                return SSE2;
+            if (supports(NEON))
+                return NEON;
+            return SCALAR;
+        }();
+        return Selected;
+    }
+
+    bool Simd::supports(const Kernel which)
+    {
+        switch (which)
+        {
+        case SCALAR:
+            return true;
+#ifdef JSON_SSE2
+        case SSE2:
+            return true;
+#endif
+#ifdef JSON_AVX2
+        case AVX2:
+        {
+            static const bool Avx2 = hasAvx2();
+            return Avx2;
+        }
+#endif
+#ifdef JSON_NEON
+        case NEON:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    Simd::ClassifyFunction Simd::classifier(const Kernel which)
+    {
+        if (!supports(which))
+            return classifyScalar;
+
+        switch (which)
+        {
+#ifdef JSON_SSE2
+        case SSE2:
+            return classifySse2;
+#endif
+#ifdef JSON_AVX2
+        case AVX2:
+            return classifyAvx2;
+#endif
+#ifdef JSON_NEON
+        case NEON:
+            return classifyNeon;
+#endif
+        default:
+            return classifyScalar;
+        }
+    }
+
+    Simd::StringFunction Simd::stringScanner(const Kernel which)
+    {
+        if (!supports(which))
+            return findStringScalar;
+
+        switch (which)
+        {
+#ifdef JSON_SSE2
+        case SSE2:
+            return findStringSse2;
+#endif
+#ifdef JSON_AVX2
+        case AVX2:
+            return findStringAvx2;
+#endif
+#ifdef JSON_NEON
+        case NEON:
+            return findStringNeon;
+#endif
+        default:
+            return findStringScalar;
+        }
+    }
+}  // namespace Rt2::Json
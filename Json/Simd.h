@@ -0,0 +1,124 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Utils/Definitions.h"
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Bit masks describing 64 consecutive bytes, bit i of each mask
+    /// corresponds to byte i of the block.
+    struct BlockMasks
+    {
+        /// quotation marks
+        U64 quote;
+        /// backslashes
+        U64 backslash;
+        /// space, tab, line feed and carriage return
+        U64 space;
+        /// '{', '}', '[', ']', ':', ','
+        U64 op;
+        /// '/', the start of a comment
+        U64 slash;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Vector kernels used by the scanner.
+    ///
+    /// The widest kernel the processor supports is selected at runtime.
+    /// Every kernel produces the same result as the scalar kernel.
+    class Simd
+    {
+    public:
+        enum Kernel
+        {
+            SCALAR,
+            SSE2,
+            AVX2,
+            NEON,
+        };
+
+        /// <summary>
+        /// Classifies 64 bytes.
+        /// </summary>
+        /// <param name="block">Points to 64 readable bytes.</param>
+        /// <param name="dest">Receives the masks for the block.</param>
+        typedef void (*ClassifyFunction)(const char* block, BlockMasks& dest);
+
+        /// <summary>
+        /// Finds the first byte in a string body that ends the run of
+        /// characters that can be copied as is.
+        /// </summary>
+        /// <param name="first">The first byte to test.</param>
+        /// <param name="last">One past the last byte to test.</param>
+        /// <param name="limit">
+        /// One past the last readable byte, not less than last. Reading past
+        /// last lets the kernels skip their scalar tail.
+        /// </param>
+        /// <returns>
+        /// The first quote, backslash or control character, or last if there is none.
+        /// </returns>
+        typedef const char* (*StringFunction)(const char* first, const char* last, const char* limit);
+
+        /// <returns>The kernel that is selected for this processor.</returns>
+        static Kernel kernel();
+
+        /// <returns>true if the supplied kernel can run on this processor.</returns>
+        static bool supports(Kernel which);
+
+        /// <summary>
+        /// Returns the classify function for the supplied kernel.
+        /// </summary>
+        /// <param name="which">
+        /// The kernel to use. If it is not supported the scalar kernel is returned.
+        /// </param>
+        static ClassifyFunction classifier(Kernel which = kernel());
+
+        /// <summary>
+        /// Returns the string body function for the supplied kernel.
+        /// </summary>
+        /// <param name="which">
+        /// The kernel to use. If it is not supported the scalar kernel is returned.
+        /// </param>
+        static StringFunction stringScanner(Kernel which = kernel());
+
+        /// <returns>The index of the lowest set bit. The argument must not be zero.</returns>
+        static U32 lowestBit(U64 bits);
+    };
+
+    inline U32 Simd::lowestBit(const U64 bits)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long idx;
+        _BitScanForward64(&idx, bits);
+        return (U32)idx;
+#else
+        return (U32)__builtin_ctzll(bits);
+#endif
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,534 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "StreamParser.h"
+#include "MemoryObjectVisitor.h"
+#include "Visitor.h"
+
+namespace Rt2::Json
+{
+    StreamParser::StreamParser(Visitor* visitor) :
+        _visitor(visitor),
+        _owns(visitor == nullptr),
+        _state(ST_ROOT),
+        _lexeme(LEX_NONE),
+        _escape(false),
+        _skip(0),
+        _findString(Simd::stringScanner())
+    {
+        if (_visitor == nullptr)
+            _visitor = new MemoryObjectVisitor();
+
+        // tokens are scanned one at a time
+        _scanner.setIndexThreshold(Npos);
+    }
+
+    StreamParser::~StreamParser()
+    {
+        if (_owns)
+            delete _visitor;
+    }
+
+    void StreamParser::reset()
+    {
+        while (!_frames.empty())
+            _frames.pop();
+
+        _state  = ST_ROOT;
+        _lexeme = LEX_NONE;
+        _escape = false;
+        _skip   = 0;
+        _partial.clear();
+        _token.clear();
+
+        // the owned visitor still holds the open nodes of the last document
+        if (_owns)
+            ((MemoryObjectVisitor*)_visitor)->reset();
+    }
+
+    bool StreamParser::feed(const char* src, const size_t sizeInBytes)
+    {
+        if (!src || _state == ST_ERROR || _state == ST_STOPPED)
+            return _state != ST_ERROR && _state != ST_STOPPED;
+
+        size_t i = 0;
+        if (_lexeme != LEX_NONE)
+            i = resume(src, 0, sizeInBytes);
+
+        while (i < sizeInBytes && _state != ST_ERROR && _state != ST_STOPPED)
+        {
+            if (_skip > 0)
+            {
+                i = skip(src, i, sizeInBytes);
+                continue;
+            }
+
+            switch (src[i])
+            {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                ++i;
+                break;
+            case '[':
+                emit(JT_L_BRACE);
+                ++i;
+                break;
+            case ']':
+                emit(JT_R_BRACE);
+                ++i;
+                break;
+            case ',':
+                emit(JT_COMMA);
+                ++i;
+                break;
+            case ':':
+                emit(JT_COLON);
+                ++i;
+                break;
+            case '{':
+                emit(JT_L_BRACKET);
+                ++i;
+                break;
+            case '}':
+                emit(JT_R_BRACKET);
+                ++i;
+                break;
+            case '"':
+            {
+                _escape = false;
+
+                const size_t end = findStringEnd(src, i + 1, sizeInBytes);
+                if (end == Npos)
+                {
+                    _partial.assign(src + i, sizeInBytes - i);
+                    _lexeme = LEX_STRING;
+                    return true;
+                }
+                emit(src + i, end - i);
+                i = end;
+                break;
+            }
+            case '/':
+                _lexeme = LEX_SLASH;
+                i       = resume(src, i + 1, sizeInBytes);
+                break;
+            default:
+            {
+                size_t end = i;
+                while (end < sizeInBytes && !Scanner::isDelimiter(src[end]))
+                    ++end;
+
+                if (end == sizeInBytes)
+                {
+                    _partial.assign(src + i, sizeInBytes - i);
+                    _lexeme = LEX_SCALAR;
+                    return true;
+                }
+                emit(src + i, end - i);
+                i = end;
+                break;
+            }
+            }
+        }
+        return _state != ST_ERROR && _state != ST_STOPPED;
+    }
+
+    Type* StreamParser::finish()
+    {
+        if (_state != ST_ERROR && _state != ST_STOPPED)
+        {
+            if (_lexeme == LEX_SCALAR)
+            {
+                // a number or literal that ends the input
+                _lexeme = LEX_NONE;
+                emit(_partial.c_str(), _partial.size());
+                _partial.clear();
+            }
+
+            if (_lexeme == LEX_STRING || _lexeme == LEX_SLASH || _state != ST_DONE)
+            {
+                _token.clear();
+                fail();
+            }
+        }
+
+        if (_state != ST_DONE)
+            return nullptr;
+        return _visitor->root();
+    }
+
+    size_t StreamParser::resume(const char* src, size_t pos, const size_t len)
+    {
+        switch (_lexeme)
+        {
+        case LEX_STRING:
+        {
+            const size_t end = findStringEnd(src, pos, len);
+            if (end == Npos)
+            {
+                _partial.append(src + pos, len - pos);
+                return len;
+            }
+
+            _partial.append(src + pos, end - pos);
+            _lexeme = LEX_NONE;
+            emit(_partial.c_str(), _partial.size());
+            _partial.clear();
+            return end;
+        }
+        case LEX_SKIPPED_STRING:
+        {
+            const size_t end = findStringEnd(src, pos, len);
+            if (end == Npos)
+                return len;
+
+            _lexeme = LEX_NONE;
+            return end;
+        }
+        case LEX_SCALAR:
+        {
+            size_t end = pos;
+            while (end < len && !Scanner::isDelimiter(src[end]))
+                ++end;
+
+            _partial.append(src + pos, end - pos);
+            if (end == len)
+                return len;
+
+            _lexeme = LEX_NONE;
+            emit(_partial.c_str(), _partial.size());
+            _partial.clear();
+            return end;
+        }
+        case LEX_SLASH:
+            if (pos >= len)
+                return len;
+            if (src[pos] != '/')
+            {
+                _lexeme = LEX_NONE;
+                _token.clear();
+                fail();
+                return len;
+            }
+            _lexeme = LEX_COMMENT;
+            ++pos;
+            [[fallthrough]];
+        case LEX_COMMENT:
+            while (pos < len && src[pos] != '\n' && src[pos] != '\r')
+                ++pos;
+            if (pos < len)
+                _lexeme = LEX_NONE;
+            return pos;
+        case LEX_NONE:
+            break;
+        }
+        return pos;
+    }
+
+    size_t StreamParser::findStringEnd(const char* src, size_t pos, const size_t len)
+    {
+        while (pos < len)
+        {
+            if (_escape)
+            {
+                _escape = false;
+                ++pos;
+                continue;
+            }
+
+            pos = (size_t)(_findString(src + pos, src + len, src + len) - src);
+            if (pos >= len)
+                break;
+
+            // control characters are left for the scanner to reject
+            const char ch = src[pos++];
+            if (ch == '\\')
+                _escape = true;
+            else if (ch == '"')
+                return pos;
+        }
+        return Npos;
+    }
+
+    size_t StreamParser::skip(const char* src, size_t pos, const size_t len)
+    {
+        // Brackets are counted without being tokenized, the same as
+        // Scanner::skip. Strings are still found so that brackets inside
+        // of them are not counted.
+        while (pos < len && _skip > 0)
+        {
+            switch (src[pos++])
+            {
+            case '[':
+            case '{':
+                ++_skip;
+                break;
+            case ']':
+            case '}':
+                if (--_skip == 0)
+                    _frames.top().state = ST_COMMA_OR_END;
+                break;
+            case '"':
+            {
+                _escape = false;
+
+                const size_t end = findStringEnd(src, pos, len);
+                if (end == Npos)
+                {
+                    _lexeme = LEX_SKIPPED_STRING;
+                    return len;
+                }
+                pos = end;
+                break;
+            }
+            case '/':
+                _lexeme = LEX_SLASH;
+                return resume(src, pos, len);
+            default:
+                break;
+            }
+        }
+        return pos;
+    }
+
+    void StreamParser::emit(const char* src, const size_t len)
+    {
+        _scanner.borrow(src, len);
+        _scanner.scan(_token);
+
+        if (!_scanner.isOpen())
+            fail();
+        else
+            handle();
+    }
+
+    void StreamParser::emit(const TokenType type)
+    {
+        _token.clear();
+        _token.setType(type);
+        handle();
+    }
+
+    void StreamParser::handle()
+    {
+        const TokenType type = _token.type();
+
+        if (_frames.empty())
+        {
+            if (_state == ST_ROOT && (type == JT_L_BRACKET || type == JT_L_BRACE))
+                value();
+            else
+                fail();
+            return;
+        }
+
+        Frame& top = _frames.top();
+        switch (top.state)
+        {
+        case ST_KEY_OR_END:
+            if (type == JT_R_BRACKET)
+            {
+                closed(type);
+                return;
+            }
+            if (type == JT_STRING)
+            {
+                const StringView key = _token.view();
+                top.key.assign(key.data(), key.size());
+
+                const VisitAction action = _visitor->keyParsed(top.key);
+                if (action == VA_STOP)
+                {
+                    _state = ST_STOPPED;
+                    return;
+                }
+                top.state = action == VA_SKIP ? ST_SKIP_COLON : ST_COLON;
+                return;
+            }
+            break;
+        case ST_COLON:
+            if (type == JT_COLON)
+            {
+                top.state = ST_MEMBER;
+                return;
+            }
+            break;
+        case ST_SKIP_COLON:
+            if (type == JT_COLON)
+            {
+                top.state = ST_SKIP_MEMBER;
+                return;
+            }
+            break;
+        case ST_SKIP_MEMBER:
+            switch (type)
+            {
+            case JT_L_BRACKET:
+            case JT_L_BRACE:
+                _skip = 1;
+                return;
+            case JT_STRING:
+            case JT_NULL:
+            case JT_BOOL:
+            case JT_NUMBER:
+            case JT_INTEGER:
+                top.state = ST_COMMA_OR_END;
+                return;
+            default:
+                break;
+            }
+            break;
+        case ST_VALUE_OR_END:
+            if (type == JT_R_BRACE)
+            {
+                closed(type);
+                return;
+            }
+            value();
+            return;
+        case ST_MEMBER:
+            value();
+            return;
+        case ST_COMMA_OR_END:
+            if (type == JT_COMMA)
+            {
+                top.state = top.object ? ST_KEY_OR_END : ST_VALUE_OR_END;
+                return;
+            }
+            if (type == (top.object ? JT_R_BRACKET : JT_R_BRACE))
+            {
+                closed(type);
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        fail();
+    }
+
+    void StreamParser::value()
+    {
+        const TokenType type = _token.type();
+        switch (type)
+        {
+        case JT_L_BRACKET:
+        case JT_L_BRACE:
+        {
+            // the parent expects a separator once this value is closed
+            if (!_frames.empty())
+                _frames.top().state = ST_COMMA_OR_END;
+
+            const bool object = type == JT_L_BRACKET;
+            _frames.push({object, object ? ST_KEY_OR_END : ST_VALUE_OR_END, String()});
+
+            if (object)
+                _visitor->objectCreated();
+            else
+                _visitor->arrayCreated();
+            return;
+        }
+        case JT_STRING:
+        case JT_NULL:
+        case JT_BOOL:
+        case JT_NUMBER:
+        case JT_INTEGER:
+            break;
+        case JT_UNDEFINED:
+        case JT_COLON:
+        case JT_COMMA:
+        case JT_R_BRACE:
+        case JT_R_BRACKET:
+            fail();
+            return;
+        }
+
+        Frame& top = _frames.top();
+        top.state  = ST_COMMA_OR_END;
+
+        if (top.object)
+        {
+            if (_token.hasInteger())
+                _visitor->keyIntegerParsed(top.key, _token.view(), _token.integer());
+            else
+                _visitor->keyValueParsed(top.key, type, _token.view());
+            return;
+        }
+
+        switch (type)
+        {
+        case JT_STRING:
+            _visitor->stringParsed(_token.view());
+            break;
+        case JT_NULL:
+            _visitor->pointerParsed(_token.view());
+            break;
+        case JT_BOOL:
+            _visitor->booleanParsed(_token.view());
+            break;
+        case JT_NUMBER:
+            _visitor->doubleParsed(_token.view());
+            break;
+        case JT_INTEGER:
+            if (_token.hasInteger())
+                _visitor->integerValueParsed(_token.view(), _token.integer());
+            else
+                _visitor->integerParsed(_token.view());
+            break;
+        default:
+            break;
+        }
+    }
+
+    void StreamParser::closed(const TokenType type)
+    {
+        const bool object = type == JT_R_BRACKET;
+        if (object)
+            _visitor->objectFinished();
+        else
+            _visitor->arrayFinished();
+
+        _frames.pop();
+        if (_frames.empty())
+        {
+            _state = ST_DONE;
+            return;
+        }
+
+        if (const Frame& parent = _frames.top(); parent.object)
+            _visitor->keyValueParsed(parent.key, object ? JT_L_BRACKET : JT_L_BRACE, StringView());
+        else if (object)
+            _visitor->objectParsed();
+        else
+            _visitor->arrayParsed();
+    }
+
+    void StreamParser::fail()
+    {
+        if (_state != ST_ERROR)
+        {
+            _state = ST_ERROR;
+            _visitor->parseError(_token);
+        }
+    }
+}  // namespace Rt2::Json
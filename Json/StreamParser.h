@@ -0,0 +1,177 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Scanner.h"
+#include "Json/Token.h"
+#include "Utils/Stack.h"
+
+namespace Rt2::Json
+{
+    class Type;
+    class Visitor;
+
+    /// \ingroup Json
+    ///
+    /// Push parser for documents that arrive in pieces.
+    ///
+    /// Each call to feed drives the visitor as far as the supplied bytes
+    /// allow. Tokens that are split between two calls, including strings
+    /// and numbers, are held until the rest of them arrives, so the only
+    /// input that is buffered is the token currently being received.
+    ///
+    /// The visitor receives the same sequence of calls that the Parser
+    /// makes for the same document, and the result of keyParsed is
+    /// honoured the same way. A skipped value is passed over without
+    /// buffering any part of it.
+    class StreamParser
+    {
+    private:
+        enum Lexeme
+        {
+            LEX_NONE,
+            LEX_STRING,
+            LEX_SCALAR,
+            LEX_SLASH,
+            LEX_COMMENT,
+            LEX_SKIPPED_STRING,
+        };
+
+        enum State
+        {
+            ST_ROOT,
+            ST_KEY_OR_END,
+            ST_COLON,
+            ST_MEMBER,
+            ST_SKIP_COLON,
+            ST_SKIP_MEMBER,
+            ST_VALUE_OR_END,
+            ST_COMMA_OR_END,
+            ST_DONE,
+            ST_ERROR,
+            ST_STOPPED,
+        };
+
+        struct Frame
+        {
+            bool   object;
+            State  state;
+            String key;
+        };
+
+        Visitor*             _visitor;
+        bool                 _owns;
+        Scanner              _scanner;
+        Token                _token;
+        Stack<Frame>         _frames;
+        State                _state;
+        Lexeme               _lexeme;
+        bool                 _escape;
+        size_t               _skip;
+        String               _partial;
+        Simd::StringFunction _findString;
+
+        size_t resume(const char* src, size_t pos, size_t len);
+
+        size_t findStringEnd(const char* src, size_t pos, size_t len);
+
+        size_t skip(const char* src, size_t pos, size_t len);
+
+        void emit(const char* src, size_t len);
+
+        void emit(TokenType type);
+
+        void handle();
+
+        void value();
+
+        void closed(TokenType type);
+
+        void fail();
+
+    public:
+        explicit StreamParser(Visitor* visitor = nullptr);
+        ~StreamParser();
+
+        /// <summary>
+        /// Parses the next piece of the document.
+        /// </summary>
+        /// <param name="src">The next bytes of the document</param>
+        /// <param name="sizeInBytes">The number of bytes in src</param>
+        /// <returns>
+        /// false if the document is malformed or the visitor stopped the parse.
+        /// </returns>
+        /// <remarks>
+        /// The memory only needs to remain valid for the duration of the call.
+        /// </remarks>
+        bool feed(const char* src, size_t sizeInBytes);
+
+        /// <summary>
+        /// Marks the end of the document.
+        /// </summary>
+        /// <returns>
+        /// The visitor's root, or null if the document is malformed or incomplete.
+        /// </returns>
+        Type* finish();
+
+        /// <summary>
+        /// Prepares the parser for a new document.
+        /// </summary>
+        /// <remarks>
+        /// When the parser created its own visitor, the nodes of the last
+        /// document are destroyed, including a root returned by finish.
+        /// </remarks>
+        void reset();
+
+        /// <returns>true once the root object or array has been closed.</returns>
+        bool done() const;
+
+        /// <returns>true if the document is malformed.</returns>
+        bool failed() const;
+
+        /// <returns>true if the visitor ended the parse with VA_STOP.</returns>
+        bool stopped() const;
+
+        /// <returns>The number of bytes held for a token that is not complete yet.</returns>
+        size_t pending() const;
+    };
+
+    inline bool StreamParser::done() const
+    {
+        return _state == ST_DONE;
+    }
+
+    inline bool StreamParser::failed() const
+    {
+        return _state == ST_ERROR;
+    }
+
+    inline bool StreamParser::stopped() const
+    {
+        return _state == ST_STOPPED;
+    }
+
+    inline size_t StreamParser::pending() const
+    {
+        return _partial.size();
+    }
+}  // namespace Rt2::Json
@@ -41,10 +41,71 @@ namespace Rt2::Json
         }
 
         void toString(StringBuilder& dest) override
+        {
+            writeQuoted(dest, _value);
+        }
+
+        /// <summary>
+        /// Writes the supplied characters as a quoted json string,
+        /// escaping any characters that cannot appear in it literally.
+        /// </summary>
+        /// <param name="dest">A destination reference</param>
+        /// <param name="str">The unescaped characters</param>
+        static void writeQuoted(StringBuilder& dest, const String& str)
         {
             dest.write('"');
-            dest.write(_value);
+
+            size_t i = 0;
+            while (i < str.size() && (U8)str[i] >= 0x20 && str[i] != '"' && str[i] != '\\')
+                ++i;
+
+            if (i == str.size())
+                dest.write(str);
+            else
+            {
+                for (const char ch : str)
+                    writeEscaped(dest, ch);
+            }
             dest.write('"');
         }
+
+    private:
+        static void writeEscaped(StringBuilder& dest, const char ch)
+        {
+            switch (ch)
+            {
+            case '"':
+                dest.write("\\\"");
+                break;
+            case '\\':
+                dest.write("\\\\");
+                break;
+            case '\b':
+                dest.write("\\b");
+                break;
+            case '\f':
+                dest.write("\\f");
+                break;
+            case '\n':
+                dest.write("\\n");
+                break;
+            case '\r':
+                dest.write("\\r");
+                break;
+            case '\t':
+                dest.write("\\t");
+                break;
+            default:
+                if ((U8)ch < 0x20)
+                {
+                    const char hex[] = "0123456789abcdef";
+                    const char esc[] = {'\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0xF], 0};
+                    dest.write(esc);
+                }
+                else
+                    dest.write(ch);
+                break;
+            }
+        }
     };
 }  // namespace Rt2::Json
@@ -0,0 +1,154 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "StructuralIndex.h"
+
+namespace Rt2::Json
+{
+    StructuralIndex::StructuralIndex() :
+        _data(nullptr),
+        _len(0),
+        _end(0),
+        _positions(nullptr),
+        _count(0),
+        _cursor(0),
+        _escaped(0),
+        _inString(0),
+        _scalar(0),
+        _classify(nullptr)
+    {
+    }
+
+    StructuralIndex::~StructuralIndex()
+    {
+        delete[] _positions;
+    }
+
+    void StructuralIndex::reset(const char* data, const size_t len, const Simd::Kernel kernel)
+    {
+        if (!_positions)
+            _positions = new size_t[Window];
+
+        _data     = data;
+        _len      = len;
+        _end      = 0;
+        _count    = 0;
+        _cursor   = 0;
+        _escaped  = 0;
+        _inString = 0;
+        _scalar   = 0;
+        _classify = Simd::classifier(kernel);
+    }
+
+    size_t StructuralIndex::next(const size_t from)
+    {
+        for (;;)
+        {
+            while (_cursor < _count)
+            {
+                if (const size_t pos = _positions[_cursor++]; pos >= from)
+                    return pos;
+            }
+
+            if (_end >= _len)
+                return _len;
+            if (!indexWindow())
+                return Npos;
+        }
+    }
+
+    bool StructuralIndex::indexWindow()
+    {
+        const size_t stop = Min(_len, _end + Window);
+
+        _count  = 0;
+        _cursor = 0;
+
+        for (size_t base = _end; base < stop; base += 64)
+        {
+            BlockMasks masks;
+            if (base + 64 <= _len)
+                _classify(_data + base, masks);
+            else
+            {
+                // whitespace contributes nothing to the index
+                char block[64];
+                memset(block, ' ', sizeof block);
+                memcpy(block, _data + base, _len - base);
+                _classify(block, masks);
+            }
+
+            const U64 quote    = masks.quote & ~findEscaped(masks.backslash, _escaped);
+            const U64 inString = prefixXor(quote) ^ _inString;
+
+            // all ones when the block ends inside of a string
+            _inString = (U64)((I64)inString >> 63);
+
+            if (masks.slash & ~inString)
+                return false;
+
+            // a scalar starts where a run of non-token bytes starts
+            const U64 scalar = ~(masks.op | masks.space | quote);
+            const U64 starts = scalar & ~(scalar << 1 | _scalar);
+            _scalar          = scalar >> 63;
+
+            U64 bits = ((masks.op | starts) & ~inString) | (quote & inString);
+            while (bits)
+            {
+                _positions[_count++] = base + Simd::lowestBit(bits);
+                bits &= bits - 1;
+            }
+        }
+
+        _end = stop;
+        return true;
+    }
+
+    U64 StructuralIndex::findEscaped(U64 backslash, U64& carry)
+    {
+        // A character is escaped when it follows an odd length run of
+        // backslashes. Runs that start on odd bits are separated from
+        // runs that start on even bits with an add, whose carry also
+        // tracks a run that continues into the next block.
+        constexpr U64 even = 0x5555555555555555;
+
+        backslash &= ~carry;
+        const U64 followsEscape = backslash << 1 | carry;
+        const U64 oddStarts     = backslash & ~even & ~followsEscape;
+
+        const U64 evenStarts = oddStarts + backslash;
+        carry                = evenStarts < oddStarts ? 1 : 0;
+
+        return (even ^ evenStarts << 1) & followsEscape;
+    }
+
+    U64 StructuralIndex::prefixXor(U64 bits)
+    {
+        // bit i becomes the xor of bits 0 through i
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,104 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Simd.h"
+#include "Utils/Definitions.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Locates the bytes where tokens start, so that the scanner can jump
+    /// from one token to the next instead of stepping over whitespace.
+    ///
+    /// The input is indexed one window at a time with the vector kernels
+    /// in Simd, which keeps memory use bounded for any size of input.
+    /// The indexed positions are the structural characters {}[]:, that
+    /// are outside of strings, the opening quote of every string, and the
+    /// first byte of every number or literal.
+    class StructuralIndex
+    {
+    public:
+        /// The number of input bytes indexed at a time.
+        static constexpr size_t Window = 0x4000;
+
+    private:
+        const char*            _data;
+        size_t                 _len;
+        size_t                 _end;
+        size_t*                _positions;
+        size_t                 _count;
+        size_t                 _cursor;
+        U64                    _escaped;
+        U64                    _inString;
+        U64                    _scalar;
+        Simd::ClassifyFunction _classify;
+
+        bool indexWindow();
+
+    public:
+        StructuralIndex();
+        ~StructuralIndex();
+
+        StructuralIndex(const StructuralIndex&)            = delete;
+        StructuralIndex& operator=(const StructuralIndex&) = delete;
+
+        /// <summary>
+        /// Starts indexing the supplied memory.
+        /// </summary>
+        /// <param name="data">The memory to index</param>
+        /// <param name="len">The size of the memory in bytes</param>
+        /// <param name="kernel">The vector kernel used to classify bytes</param>
+        void reset(const char* data, size_t len, Simd::Kernel kernel = Simd::kernel());
+
+        /// <summary>
+        /// Finds the first token start at or after the supplied offset.
+        /// </summary>
+        /// <param name="from">
+        /// The offset to search from. It must not be less than the
+        /// offset passed to the previous call.
+        /// </param>
+        /// <returns>
+        /// The offset of the token, the input length if there are no more
+        /// tokens, or Npos if the input contains a comment. Comments are not
+        /// indexed, the caller is expected to scan the rest byte by byte.
+        /// </returns>
+        size_t next(size_t from);
+
+        /// <summary>
+        /// Finds the characters in a block that are escaped by a backslash.
+        /// </summary>
+        /// <param name="backslash">The backslash mask of the block</param>
+        /// <param name="carry">
+        /// One if the previous block ended with an unfinished escape. It is
+        /// updated for the next block.
+        /// </param>
+        static U64 findEscaped(U64 backslash, U64& carry);
+
+        /// <returns>
+        /// A mask where bit i is the xor of bits 0 through i, which turns
+        /// a mask of quotes into a mask of string contents.
+        /// </returns>
+        static U64 prefixXor(U64 bits);
+    };
+}  // namespace Rt2::Json
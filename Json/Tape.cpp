@@ -0,0 +1,564 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Tape.h"
+#include <cstring>
+#include "Number.h"
+#include "Scanner.h"
+#include "StringType.h"
+
+namespace Rt2::Json
+{
+    void Tape::clear()
+    {
+        _words.clear();
+        _strings.clear();
+    }
+
+    bool Tape::parse(const String& path)
+    {
+        Scanner scn;
+        scn.open(path);
+
+        if (!scn.isOpen())
+        {
+            Console::writeError("failed to open the supplied file: ", path.c_str());
+            return false;
+        }
+        return finish(build(scn));
+    }
+
+    bool Tape::parse(const char* src, const size_t sizeInBytes, const size_t padding)
+    {
+        Scanner scn;
+        scn.borrow(src, sizeInBytes, padding);
+
+        if (!scn.isOpen())
+        {
+            Console::writeError("failed to open the supplied memory file");
+            return false;
+        }
+        return finish(build(scn));
+    }
+
+    bool Tape::finish(const bool result)
+    {
+        if (!result)
+        {
+            Console::writeError("Parse error: malformed document");
+            clear();
+        }
+        return result;
+    }
+
+    void Tape::append(const Tag tag, const U64 payload)
+    {
+        _words.push_back((U64)tag << 56 | (payload & PayloadMask));
+    }
+
+    void Tape::appendString(const StringView& str)
+    {
+        append(TAG_STRING, _strings.size());
+
+        const U32 len = (U32)str.size();
+        _strings.append((const char*)&len, sizeof(U32));
+        _strings.append(str.data(), str.size());
+        _strings.push_back(0);
+    }
+
+    bool Tape::appendScalar(const Token& tok)
+    {
+        const StringView text = tok.view();
+        switch (tok.type())
+        {
+        case JT_STRING:
+            appendString(text);
+            return true;
+        case JT_NULL:
+            append(TAG_NULL, 0);
+            return true;
+        case JT_BOOL:
+            append(text == "true" ? TAG_TRUE : TAG_FALSE, 0);
+            return true;
+        case JT_INTEGER:
+            if (tok.hasInteger())
+            {
+                append(TAG_INTEGER, 0);
+                _words.push_back((U64)tok.integer());
+                return true;
+            }
+            if (text[0] != '-')
+            {
+                const char* cur = text.data();
+                U64         value;
+                if (Number::parseUnsigned(cur, text.data() + text.size(), value) &&
+                    cur == text.data() + text.size())
+                {
+                    append(TAG_UNSIGNED, 0);
+                    _words.push_back(value);
+                    return true;
+                }
+            }
+            // out of range integers are kept as doubles
+            [[fallthrough]];
+        case JT_NUMBER:
+        {
+            double value = 0;
+            if (!Number::parseDouble(text.data(), text.data() + text.size(), value))
+                return false;
+
+            U64 bits;
+            std::memcpy(&bits, &value, sizeof(U64));
+            append(TAG_DOUBLE, 0);
+            _words.push_back(bits);
+            return true;
+        }
+        case JT_UNDEFINED:
+        case JT_L_BRACE:
+        case JT_R_BRACE:
+        case JT_L_BRACKET:
+        case JT_R_BRACKET:
+        case JT_COLON:
+        case JT_COMMA:
+            break;
+        }
+        return false;
+    }
+
+    bool Tape::build(Scanner& scn)
+    {
+        enum Expect
+        {
+            EX_KEY,
+            EX_COLON,
+            EX_VALUE,
+            EX_COMMA,
+        };
+
+        clear();
+
+        // open containers and their element counts
+        Array<U32> open;
+        Array<U32> counts;
+
+        Token  tok;
+        Expect expect;
+
+        scn.scan(tok);
+        if (tok.type() != JT_L_BRACKET && tok.type() != JT_L_BRACE)
+        {
+            Console::writeError("the root must be an object or an array");
+            return false;
+        }
+
+        open.push_back(0);
+        counts.push_back(0);
+        append(tok.type() == JT_L_BRACKET ? TAG_OBJECT_START : TAG_ARRAY_START, 0);
+        expect = tok.type() == JT_L_BRACKET ? EX_KEY : EX_VALUE;
+
+        for (scn.scan(tok); scn.isOpen(); scn.scan(tok))
+        {
+            const TokenType type = tok.type();
+            if (type == JT_NULL && tok.view().empty())
+                break;  // the end of the input
+
+            const bool object = tag(_words.at(open.back())) == TAG_OBJECT_START;
+
+            switch (expect)
+            {
+            case EX_KEY:
+                if (type == JT_STRING)
+                {
+                    appendString(tok.view());
+                    ++counts.back();
+                    expect = EX_COLON;
+                }
+                else if (type == JT_R_BRACKET)
+                    expect = EX_COMMA;
+                else
+                    return false;
+                break;
+            case EX_COLON:
+                if (type != JT_COLON)
+                    return false;
+                expect = EX_VALUE;
+                break;
+            case EX_VALUE:
+                if (type == JT_L_BRACKET || type == JT_L_BRACE)
+                {
+                    if (!object)
+                        ++counts.back();
+
+                    open.push_back(_words.size());
+                    counts.push_back(0);
+                    append(type == JT_L_BRACKET ? TAG_OBJECT_START : TAG_ARRAY_START, 0);
+                    expect = type == JT_L_BRACKET ? EX_KEY : EX_VALUE;
+                }
+                else if (type == JT_R_BRACE && !object)
+                    expect = EX_COMMA;
+                else if (appendScalar(tok))
+                {
+                    if (!object)
+                        ++counts.back();
+                    expect = EX_COMMA;
+                }
+                else
+                    return false;
+                break;
+            case EX_COMMA:
+                if (type == JT_COMMA)
+                    expect = object ? EX_KEY : EX_VALUE;
+                else if (type != (object ? JT_R_BRACKET : JT_R_BRACE))
+                    return false;
+                break;
+            }
+
+            // close the container once its end token has been accepted
+            if (expect == EX_COMMA && (type == JT_R_BRACKET || type == JT_R_BRACE))
+            {
+                const U32 start = open.back();
+                const U32 count = counts.back() < MaxCount ? counts.back() : MaxCount;
+                open.pop_back();
+                counts.pop_back();
+
+                append(type == JT_R_BRACKET ? TAG_OBJECT_END : TAG_ARRAY_END, start);
+                _words.at(start) |= (U64)count << 32 | _words.size();
+
+                if (open.empty())
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    U64 TapeValue::next() const
+    {
+        const U64 value = word();
+        switch (Tape::tag(value))
+        {
+        case Tape::TAG_ARRAY_START:
+        case Tape::TAG_OBJECT_START:
+            return value & 0xFFFFFFFF;
+        case Tape::TAG_INTEGER:
+        case Tape::TAG_UNSIGNED:
+        case Tape::TAG_DOUBLE:
+            return (U64)_index + 2;
+        default:
+            return (U64)_index + 1;
+        }
+    }
+
+    Type::ClassType TapeValue::type() const
+    {
+        if (!valid())
+            return Type::UNDEFINED;
+
+        switch (Tape::tag(word()))
+        {
+        case Tape::TAG_ARRAY_START:
+            return Type::ARRAY;
+        case Tape::TAG_OBJECT_START:
+            return Type::OBJECT;
+        case Tape::TAG_STRING:
+            return Type::STRING;
+        case Tape::TAG_INTEGER:
+        case Tape::TAG_UNSIGNED:
+            return Type::INTEGER;
+        case Tape::TAG_DOUBLE:
+            return Type::DOUBLE;
+        case Tape::TAG_TRUE:
+        case Tape::TAG_FALSE:
+            return Type::BOOLEAN;
+        case Tape::TAG_NULL:
+            return Type::POINTER;
+        default:
+            return Type::UNDEFINED;
+        }
+    }
+
+    StringView TapeValue::string() const
+    {
+        if (!isString())
+            return {};
+
+        const char* base = _tape->strings().data() + Tape::payload(word());
+
+        U32 len;
+        std::memcpy(&len, base, sizeof(U32));
+        return {base + sizeof(U32), len};
+    }
+
+    I16 TapeValue::i16(const I16 defaultValue) const
+    {
+        return (I16)i64(defaultValue);
+    }
+
+    I32 TapeValue::i32(const I32 defaultValue) const
+    {
+        return (I32)i64(defaultValue);
+    }
+
+    I64 TapeValue::i64(const I64 defaultValue) const
+    {
+        if (!valid() || Tape::tag(word()) != Tape::TAG_INTEGER)
+            return defaultValue;
+        return (I64)_tape->at(_index + 1);
+    }
+
+    U16 TapeValue::u16(const U16 defaultValue) const
+    {
+        return (U16)u64(defaultValue);
+    }
+
+    U32 TapeValue::u32(const U32 defaultValue) const
+    {
+        return (U32)u64(defaultValue);
+    }
+
+    U64 TapeValue::u64(const U64 defaultValue) const
+    {
+        if (!isInteger())
+            return defaultValue;
+
+        const U64 value = _tape->at(_index + 1);
+        if (Tape::tag(word()) == Tape::TAG_INTEGER && (I64)value < 0)
+            return defaultValue;
+        return value;
+    }
+
+    double TapeValue::r64(const double defaultValue) const
+    {
+        if (!isDouble())
+            return defaultValue;
+
+        const U64 bits = _tape->at(_index + 1);
+
+        double value;
+        std::memcpy(&value, &bits, sizeof(double));
+        return value;
+    }
+
+    bool TapeValue::boolean(const bool defaultValue) const
+    {
+        if (!isBoolean())
+            return defaultValue;
+        return Tape::tag(word()) == Tape::TAG_TRUE;
+    }
+
+    TapeArray TapeValue::asArray() const
+    {
+        return TapeArray(*this);
+    }
+
+    TapeObject TapeValue::asObject() const
+    {
+        return TapeObject(*this);
+    }
+
+    void TapeValue::toString(StringBuilder& dest) const
+    {
+        switch (type())
+        {
+        case Type::ARRAY:
+        {
+            dest.write('[');
+            bool first = true;
+            for (const TapeValue& value : asArray())
+            {
+                if (!first)
+                    dest.write(',');
+                first = false;
+                value.toString(dest);
+            }
+            dest.write(']');
+            break;
+        }
+        case Type::OBJECT:
+        {
+            dest.write('{');
+            bool first = true;
+            for (const auto& [key, value] : asObject())
+            {
+                if (!first)
+                    dest.write(',');
+                first = false;
+                StringType::writeQuoted(dest, String(key));
+                dest.write(':');
+                value.toString(dest);
+            }
+            dest.write('}');
+            break;
+        }
+        case Type::STRING:
+            StringType::writeQuoted(dest, String(string()));
+            break;
+        case Type::INTEGER:
+        {
+            char buf[Number::IntegerBufferSize];
+            if (Tape::tag(word()) == Tape::TAG_UNSIGNED)
+                Number::formatUnsigned(u64(), buf);
+            else
+                Number::formatInteger(i64(), buf);
+            dest.write(buf);
+            break;
+        }
+        case Type::DOUBLE:
+        {
+            char buf[Number::DoubleBufferSize];
+            Number::formatDouble(r64(), buf);
+            dest.write(buf);
+            break;
+        }
+        case Type::BOOLEAN:
+            dest.write(boolean() ? "true" : "false");
+            break;
+        case Type::POINTER:
+            dest.write("null");
+            break;
+        case Type::UNDEFINED:
+            break;
+        }
+    }
+
+    String TapeValue::toString() const
+    {
+        StringBuilder sb;
+        toString(sb);
+        return sb.toString();
+    }
+
+    TapeArray::TapeArray(const TapeValue& value) :
+        TapeValue(value.isArray() ? value : TapeValue())
+    {
+    }
+
+    U32 TapeArray::size() const
+    {
+        if (!valid())
+            return 0;
+
+        if (const U32 count = (U32)(Tape::payload(word()) >> 32); count < Tape::MaxCount)
+            return count;
+
+        U32 count = 0;
+        for (auto it = begin(); it != end(); ++it)
+            ++count;
+        return count;
+    }
+
+    TapeValue TapeArray::at(U32 idx) const
+    {
+        for (auto it = begin(); it != end(); ++it)
+        {
+            if (idx-- == 0)
+                return *it;
+        }
+        return {};
+    }
+
+    TapeArray::Iterator TapeArray::begin() const
+    {
+        return Iterator(valid() ? TapeValue(_tape, _index + 1) : TapeValue());
+    }
+
+    TapeArray::Iterator TapeArray::end() const
+    {
+        return Iterator(valid() ? TapeValue(_tape, (U32)next() - 1) : TapeValue());
+    }
+
+    TapeObject::TapeObject(const TapeValue& value) :
+        TapeValue(value.isObject() ? value : TapeValue())
+    {
+    }
+
+    TapeObject::Member TapeObject::Iterator::operator*() const
+    {
+        const TapeValue key(_tape, _index);
+        return {key.string(), TapeValue(_tape, _index + 1)};
+    }
+
+    TapeObject::Iterator& TapeObject::Iterator::operator++()
+    {
+        _index = (U32)TapeValue(_tape, _index + 1).next();
+        return *this;
+    }
+
+    U32 TapeObject::size() const
+    {
+        if (!valid())
+            return 0;
+
+        if (const U32 count = (U32)(Tape::payload(word()) >> 32); count < Tape::MaxCount)
+            return count;
+
+        U32 count = 0;
+        for (auto it = begin(); it != end(); ++it)
+            ++count;
+        return count;
+    }
+
+    bool TapeObject::hasKey(const StringView& key) const
+    {
+        return find(key).valid();
+    }
+
+    TapeValue TapeObject::find(const StringView& key) const
+    {
+        for (const auto& [name, value] : *this)
+        {
+            if (name == key)
+                return value;
+        }
+        return {};
+    }
+
+    StringView TapeObject::string(const StringView& key, const StringView& def) const
+    {
+        if (const TapeValue value = find(key); value.isString())
+            return value.string();
+        return def;
+    }
+
+    I64 TapeObject::integer(const StringView& key, const I64 def) const
+    {
+        return find(key).i64(def);
+    }
+
+    double TapeObject::r64(const StringView& key, const double def) const
+    {
+        return find(key).r64(def);
+    }
+
+    bool TapeObject::boolean(const StringView& key, const bool def) const
+    {
+        return find(key).boolean(def);
+    }
+
+    TapeObject::Iterator TapeObject::begin() const
+    {
+        return {_tape, valid() ? _index + 1 : 0};
+    }
+
+    TapeObject::Iterator TapeObject::end() const
+    {
+        return {_tape, valid() ? (U32)next() - 1 : 0};
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,451 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Token.h"
+#include "Json/Type.h"
+#include "Utils/Array.h"
+
+namespace Rt2::Json
+{
+    class Scanner;
+    class Tape;
+    class TapeArray;
+    class TapeObject;
+
+    /// \ingroup Json
+    ///
+    /// Read-only handle to a value on a Tape.
+    ///
+    /// A handle is a tape pointer and an index, so it is cheap to copy.
+    /// It is only valid as long as the tape it came from is unchanged.
+    class TapeValue
+    {
+    protected:
+        const Tape* _tape;
+        U32         _index;
+
+        U64 word() const;
+
+        U64 next() const;
+
+        friend class Tape;
+        friend class TapeArray;
+        friend class TapeObject;
+
+    public:
+        TapeValue() :
+            _tape(nullptr),
+            _index(0)
+        {
+        }
+
+        TapeValue(const Tape* tape, const U32 index) :
+            _tape(tape),
+            _index(index)
+        {
+        }
+
+        /// <returns>false if the handle does not reference a value.</returns>
+        bool valid() const;
+
+        /// <returns>The Type class code that corresponds to the value.</returns>
+        Type::ClassType type() const;
+
+        /// <returns>
+        /// The characters of a string value, or an empty view for any other type.
+        /// </returns>
+        StringView string() const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is above the signed range.
+        I16 i16(I16 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is above the signed range.
+        I32 i32(I32 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is above the signed range.
+        I64 i64(I64 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is negative.
+        U16 u16(U16 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is negative.
+        U32 u32(U32 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not an INTEGER
+        /// or is negative.
+        U64 u64(U64 defaultValue = -1) const;
+
+        /// Returns the value or the default parameter if it is not a DOUBLE.
+        double r64(double defaultValue = 0.0) const;
+
+        /// Returns the value or the default parameter if it is not a BOOLEAN.
+        bool boolean(bool defaultValue = false) const;
+
+        /// <returns>An array handle, which is invalid if the value is not an array.</returns>
+        TapeArray asArray() const;
+
+        /// <returns>An object handle, which is invalid if the value is not an object.</returns>
+        TapeObject asObject() const;
+
+        /// <returns>true if the value is a string</returns>
+        bool isString() const;
+
+        /// <returns>true if the value is an integer</returns>
+        bool isInteger() const;
+
+        /// <returns>true if the value is a double</returns>
+        bool isDouble() const;
+
+        /// <returns>true if the value is a bool</returns>
+        bool isBoolean() const;
+
+        /// <returns>true if the value is null</returns>
+        bool isNull() const;
+
+        /// <returns>true if the value is an object</returns>
+        bool isObject() const;
+
+        /// <returns>true if the value is an array</returns>
+        bool isArray() const;
+
+        /// <summary>
+        /// Writes the value in the same form as Type::toString.
+        /// </summary>
+        /// <param name="dest">A destination reference</param>
+        void toString(StringBuilder& dest) const;
+
+        /// <returns>Returns a string representation of the value.</returns>
+        String toString() const;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Array view of a TapeValue.
+    class TapeArray : public TapeValue
+    {
+    public:
+        class Iterator
+        {
+        private:
+            TapeValue _value;
+
+        public:
+            explicit Iterator(const TapeValue& value) :
+                _value(value)
+            {
+            }
+
+            const TapeValue& operator*() const
+            {
+                return _value;
+            }
+
+            const TapeValue* operator->() const
+            {
+                return &_value;
+            }
+
+            Iterator& operator++()
+            {
+                _value._index = (U32)_value.next();
+                return *this;
+            }
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return _value._index != rhs._value._index;
+            }
+        };
+
+        TapeArray() = default;
+
+        explicit TapeArray(const TapeValue& value);
+
+        /// <returns>The number of elements in the array.</returns>
+        U32 size() const;
+
+        /// <summary>
+        /// Walks to the element at the supplied index.
+        /// </summary>
+        /// <returns>An invalid handle if the index is out of range.</returns>
+        TapeValue at(U32 idx) const;
+
+        Iterator begin() const;
+
+        Iterator end() const;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Object view of a TapeValue.
+    class TapeObject : public TapeValue
+    {
+    public:
+        struct Member
+        {
+            StringView first;
+            TapeValue  second;
+        };
+
+        class Iterator
+        {
+        private:
+            const Tape* _tape;
+            U32         _index;
+
+        public:
+            Iterator(const Tape* tape, const U32 index) :
+                _tape(tape),
+                _index(index)
+            {
+            }
+
+            Member operator*() const;
+
+            Iterator& operator++();
+
+            bool operator!=(const Iterator& rhs) const
+            {
+                return _index != rhs._index;
+            }
+        };
+
+        TapeObject() = default;
+
+        explicit TapeObject(const TapeValue& value);
+
+        /// <returns>The number of members in the object.</returns>
+        U32 size() const;
+
+        /// <returns>true if the object has a member with the supplied key</returns>
+        bool hasKey(const StringView& key) const;
+
+        /// <returns>The member's value, or an invalid handle if there is no such key.</returns>
+        TapeValue find(const StringView& key) const;
+
+        /// Returns the member's value as a string, or the default parameter.
+        StringView string(const StringView& key, const StringView& def = {}) const;
+
+        /// Returns the member's value as an integer, or the default parameter.
+        I64 integer(const StringView& key, I64 def = -1) const;
+
+        /// Returns the member's value as a double, or the default parameter.
+        double r64(const StringView& key, double def = 0.0) const;
+
+        /// Returns the member's value as a bool, or the default parameter.
+        bool boolean(const StringView& key, bool def = false) const;
+
+        Iterator begin() const;
+
+        Iterator end() const;
+    };
+
+    /// \ingroup Json
+    ///
+    /// Flat, read-only document format.
+    ///
+    /// The document is stored as one contiguous array of tagged 64-bit
+    /// words in document order, plus one buffer that holds every string.
+    /// The tag is kept in the top byte of each word.
+    ///
+    /// - Containers are a start word and an end word. The start word holds
+    ///   the index after the end word and the element count. The end word
+    ///   holds the index of the start word.
+    /// - Strings hold an offset into the string buffer, where a 32-bit
+    ///   length is followed by the characters and a terminating null.
+    /// - Integers and doubles are followed by a second word that holds the
+    ///   raw 64-bit value. Integers above the signed range are tagged as
+    ///   unsigned.
+    /// - Object members are a key string followed by the value.
+    ///
+    /// Traversal never follows a pointer, and skipping a container is a
+    /// single jump.
+    class Tape
+    {
+    public:
+        enum Tag : U8
+        {
+            TAG_ARRAY_START  = '[',
+            TAG_ARRAY_END    = ']',
+            TAG_OBJECT_START = '{',
+            TAG_OBJECT_END   = '}',
+            TAG_STRING       = '"',
+            TAG_INTEGER      = 'l',
+            TAG_UNSIGNED     = 'u',
+            TAG_DOUBLE       = 'd',
+            TAG_TRUE         = 't',
+            TAG_FALSE        = 'f',
+            TAG_NULL         = 'n',
+        };
+
+        static constexpr U64 PayloadMask = 0x00FFFFFFFFFFFFFF;
+
+        /// <summary>
+        /// The largest element count that is stored. Larger containers
+        /// report this count, and size() falls back to counting.
+        /// </summary>
+        static constexpr U32 MaxCount = 0xFFFFFF;
+
+    private:
+        Array<U64> _words;
+        String     _strings;
+
+        void append(Tag tag, U64 payload);
+
+        void appendString(const StringView& str);
+
+        bool appendScalar(const Token& tok);
+
+        bool build(Scanner& scn);
+
+        bool finish(bool result);
+
+    public:
+        Tape() = default;
+
+        /// <summary>
+        /// Replaces the tape with the parsed file.
+        /// </summary>
+        /// <param name="path">File system path</param>
+        /// <returns>false if the file could not be parsed.</returns>
+        bool parse(const String& path);
+
+        /// <summary>
+        /// Replaces the tape with the parsed memory.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <param name="padding">See Scanner::borrow</param>
+        /// <returns>false if the memory could not be parsed.</returns>
+        bool parse(const char* src, size_t sizeInBytes, size_t padding = 0);
+
+        /// <summary>
+        /// Removes the contents of the tape.
+        /// </summary>
+        void clear();
+
+        /// <returns>The root value, which is invalid if the tape is empty.</returns>
+        TapeValue root() const;
+
+        /// <returns>The number of 64-bit words on the tape.</returns>
+        U32 size() const;
+
+        /// <returns>The word at the supplied index.</returns>
+        U64 at(U32 idx) const;
+
+        /// <returns>The string buffer.</returns>
+        const String& strings() const;
+
+        /// <returns>The tag part of a word.</returns>
+        static Tag tag(U64 word);
+
+        /// <returns>The payload part of a word.</returns>
+        static U64 payload(U64 word);
+    };
+
+    inline U32 Tape::size() const
+    {
+        return _words.size();
+    }
+
+    inline U64 Tape::at(const U32 idx) const
+    {
+        return _words.at(idx);
+    }
+
+    inline const String& Tape::strings() const
+    {
+        return _strings;
+    }
+
+    inline Tape::Tag Tape::tag(const U64 word)
+    {
+        return (Tag)(word >> 56);
+    }
+
+    inline U64 Tape::payload(const U64 word)
+    {
+        return word & PayloadMask;
+    }
+
+    inline TapeValue Tape::root() const
+    {
+        return _words.empty() ? TapeValue() : TapeValue(this, 0);
+    }
+
+    inline bool TapeValue::valid() const
+    {
+        return _tape != nullptr;
+    }
+
+    inline U64 TapeValue::word() const
+    {
+        return _tape->at(_index);
+    }
+
+    inline bool TapeValue::isString() const
+    {
+        return valid() && Tape::tag(word()) == Tape::TAG_STRING;
+    }
+
+    inline bool TapeValue::isInteger() const
+    {
+        if (!valid())
+            return false;
+        const Tape::Tag tag = Tape::tag(word());
+        return tag == Tape::TAG_INTEGER || tag == Tape::TAG_UNSIGNED;
+    }
+
+    inline bool TapeValue::isDouble() const
+    {
+        return valid() && Tape::tag(word()) == Tape::TAG_DOUBLE;
+    }
+
+    inline bool TapeValue::isBoolean() const
+    {
+        if (!valid())
+            return false;
+        const Tape::Tag tag = Tape::tag(word());
+        return tag == Tape::TAG_TRUE || tag == Tape::TAG_FALSE;
+    }
+
+    inline bool TapeValue::isNull() const
+    {
+        return valid() && Tape::tag(word()) == Tape::TAG_NULL;
+    }
+
+    inline bool TapeValue::isObject() const
+    {
+        return valid() && Tape::tag(word()) == Tape::TAG_OBJECT_START;
+    }
+
+    inline bool TapeValue::isArray() const
+    {
+        return valid() && Tape::tag(word()) == Tape::TAG_ARRAY_START;
+    }
+}  // namespace Rt2::Json
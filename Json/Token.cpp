@@ -24,24 +24,47 @@
 namespace Rt2::Json
 {
     Token::Token() :
+        _span(nullptr),
+        _length(0),
+        _integer(0),
+        _hasInteger(false),
         _type(JT_UNDEFINED)
     {
     }
 
     void Token::push(const char value)
     {
+        if (_span)
+        {
+            _value.assign(_span, _length);
+            _span = nullptr;
+        }
         _value.push_back(value);
     }
 
-    void Token::push(const String& value)
+    void Token::push(const StringView& value)
     {
-        _value.append(value);
+        if (_span)
+        {
+            _value.assign(_span, _length);
+            _span = nullptr;
+        }
+        _value.append(value.data(), value.size());
+    }
+
+    void Token::setSpan(const char* mem, const size_t len)
+    {
+        _span   = mem;
+        _length = len;
     }
 
     void Token::clear()
     {
-        _type = JT_NULL;
+        _type   = JT_NULL;
+        _span   = nullptr;
+        _length = 0;
         _value.clear();
+        _hasInteger = false;
     }
 
 }  // namespace Rt2::Json
\ No newline at end of file
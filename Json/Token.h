@@ -21,10 +21,16 @@
 */
 #pragma once
 
+#include <string_view>
+#include "Utils/Definitions.h"
 #include "Utils/String.h"
 
 namespace Rt2::Json
 {
+    /// \ingroup Json
+    ///
+    /// Non-owning reference to a run of characters.
+    using StringView = std::string_view;
 
     class Type;
     class ArrayType;
@@ -52,27 +58,55 @@ namespace Rt2::Json
 
     /// \ingroup Json
     ///
+    /// A token either references its characters in the scanner's buffer
+    /// or, when the characters had to be decoded, owns a copy of them.
     class Token
     {
     private:
-        String    _value;
-        TokenType _type;
+        mutable const char* _span;
+        size_t              _length;
+        mutable String      _value;
+        I64                 _integer;
+        bool                _hasInteger;
+        TokenType           _type;
 
     public:
         Token();
         ~Token() = default;
 
         /// <summary>
-        ///
+        /// Appends a character to the token's own storage.
         /// </summary>
         /// <param name="value">char</param>
         void push(char value);
 
         /// <summary>
-        ///
+        /// Appends a character sequence to the token's own storage.
         /// </summary>
-        /// <param name="value">const String&</param>
-        void push(const String& value);
+        /// <param name="value">The characters to append</param>
+        void push(const StringView& value);
+
+        /// <summary>
+        /// Makes the token reference memory that it does not own.
+        /// </summary>
+        /// <param name="mem">The first character of the token</param>
+        /// <param name="len">The number of characters in the token</param>
+        /// <remarks>
+        /// The memory must outlive any use of the token's value.
+        /// </remarks>
+        void setSpan(const char* mem, size_t len);
+
+        /// <summary>
+        /// Attaches the binary value of an integer token.
+        /// </summary>
+        /// <param name="value">The decoded integer</param>
+        void setInteger(I64 value);
+
+        /// <returns>true if the token carries a decoded integer.</returns>
+        bool hasInteger() const;
+
+        /// <returns>The decoded integer, which is only valid if hasInteger is true.</returns>
+        I64 integer() const;
 
         /// <summary>
         ///
@@ -80,9 +114,17 @@ namespace Rt2::Json
         void clear();
 
         /// <summary>
-        ///
+        /// Provides access to the characters without copying them.
         /// </summary>
-        /// <returns></returns>
+        StringView view() const;
+
+        /// <summary>
+        /// Provides access to the characters as a string.
+        /// </summary>
+        /// <remarks>
+        /// A referenced span is copied into the token's own storage on the
+        /// first call, prefer view() where a String is not needed.
+        /// </remarks>
         const String& value() const;
 
         /// <summary>
@@ -98,11 +140,39 @@ namespace Rt2::Json
         void setType(const TokenType& type);
     };
 
+    inline StringView Token::view() const
+    {
+        if (_span)
+            return {_span, _length};
+        return {_value.c_str(), _value.size()};
+    }
+
     inline const String& Token::value() const
     {
+        if (_span)
+        {
+            _value.assign(_span, _length);
+            _span = nullptr;
+        }
         return _value;
     }
 
+    inline void Token::setInteger(const I64 value)
+    {
+        _integer    = value;
+        _hasInteger = true;
+    }
+
+    inline bool Token::hasInteger() const
+    {
+        return _hasInteger;
+    }
+
+    inline I64 Token::integer() const
+    {
+        return _integer;
+    }
+
     inline const TokenType& Token::type() const
     {
         return _type;
@@ -21,16 +21,146 @@
 */
 #include "Type.h"
 #include "ArrayType.h"
+#include "Number.h"
 #include "ObjectType.h"
+#include "Utils/Array.h"
 
 namespace Rt2::Json
 {
-    void Type::setValue(const String& mem)
+    void Type::setValue(const StringView& mem)
     {
-        _value.assign(mem.c_str(), mem.size());
+        _value.assign(mem.data(), mem.size());
+        _flags = (_flags | HAS_TEXT) & ~(RAW_TEXT | FROZEN);
+        readScalar();
         notifyStringChanged();
     }
 
+    void Type::setRaw(const StringView& mem)
+    {
+        _value.assign(mem.data(), mem.size());
+        _flags = (_flags | HAS_TEXT | RAW_TEXT) & ~(HAS_SCALAR | FROZEN);
+        notifyStringChanged();
+    }
+
+    void Type::readScalar() const
+    {
+        switch (_type)
+        {
+        case INTEGER:
+        {
+            _flags &= ~UNSIGNED;
+
+            const char* cur = _value.data();
+            if (Number::parseInteger(cur, cur + _value.size(), _scalar.i64))
+                break;
+
+            // values above the signed range keep all of their bits
+            if (!_value.empty() && _value[0] == '-')
+                _scalar.i64 = Char::toInt64(_value);
+            else
+            {
+                _scalar.u64 = Char::toUint64(_value);
+                _flags |= UNSIGNED;
+            }
+            break;
+        }
+        case DOUBLE:
+            if (!Number::parseDouble(_value.data(), _value.data() + _value.size(), _scalar.r64))
+                _scalar.r64 = Char::toDouble(_value);
+            break;
+        case BOOLEAN:
+            _scalar.boolean = Char::toBool(_value);
+            break;
+        case POINTER:
+            if (_value == "null")
+                _scalar.u64 = 0;
+            else
+                _scalar.u64 = Char::toUint64(_value);
+            break;
+        default:
+            break;
+        }
+        _flags |= HAS_SCALAR;
+    }
+
+    void Type::writeText() const
+    {
+        switch (_type)
+        {
+        case INTEGER:
+        {
+            char         buf[Number::IntegerBufferSize];
+            const size_t len = _flags & UNSIGNED ? Number::formatUnsigned(_scalar.u64, buf)
+                                                 : Number::formatInteger(_scalar.i64, buf);
+            _value.assign(buf, len);
+            break;
+        }
+        case DOUBLE:
+        {
+            char buf[Number::DoubleBufferSize];
+            _value.assign(buf, Number::formatDouble(_scalar.r64, buf));
+            break;
+        }
+        case BOOLEAN:
+            Char::toString(_value, _scalar.boolean);
+            break;
+        case POINTER:
+            if (!_scalar.u64)
+                _value.assign("null");
+            else
+                Char::toString(_value, _scalar.u64);
+            break;
+        default:
+            break;
+        }
+        _flags |= HAS_TEXT;
+    }
+
+    void Type::releaseAll(Array<Type*>& stack)
+    {
+        while (!stack.empty())
+        {
+            Type* type = stack.back();
+            stack.pop_back();
+
+            if (type && !type->isArenaAllocated())
+            {
+                type->detach(stack);
+                delete type;
+            }
+        }
+    }
+
+    void Type::freeze()
+    {
+        // Nesting is followed with a stack, like the parser, so deep
+        // trees do not use the call stack. Frozen children are visited
+        // too, as anything below them may have changed since.
+        Array<Type*> stack;
+        stack.push_back(this);
+
+        while (!stack.empty())
+        {
+            Type* type = stack.back();
+            stack.pop_back();
+
+            type->string();
+            type->scalar();
+            type->_flags |= FROZEN;
+
+            if (ObjectType* obj = type->asObject())
+            {
+                for (const auto& it : obj->dictionary())
+                    stack.push_back(it.second);
+            }
+            else if (ArrayType* arr = type->asArray())
+            {
+                for (U32 i = 0; i < arr->size(); ++i)
+                    stack.push_back(arr->at(i));
+            }
+        }
+    }
+
     ArrayType* Type::asArray()
     {
         if (_type == ARRAY)
@@ -45,4 +175,18 @@ namespace Rt2::Json
         return nullptr;
     }
 
+    const ArrayType* Type::asArray() const
+    {
+        if (_type == ARRAY)
+            return (const ArrayType*)this;
+        return nullptr;
+    }
+
+    const ObjectType* Type::asObject() const
+    {
+        if (_type == OBJECT)
+            return (const ObjectType*)this;
+        return nullptr;
+    }
+
 }  // namespace Rt2::Json
\ No newline at end of file
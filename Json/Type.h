@@ -21,6 +21,8 @@
 */
 #pragma once
 
+#include "Json/Token.h"
+#include "Utils/Array.h"
 #include "Utils/Char.h"
 #include "Utils/Definitions.h"
 #include "Utils/String.h"
@@ -30,6 +32,7 @@ namespace Rt2::Json
 {
 
     class ArrayType;
+    class Document;
     class ObjectType;
 
     /// \ingroup Json
@@ -58,19 +61,63 @@ namespace Rt2::Json
             POINTER
         };
 
+        enum Flags
+        {
+            /// The node is owned by a Document's arena
+            ARENA = 0x01,
+            /// _value holds the current string form of the value
+            HAS_TEXT = 0x02,
+            /// _scalar holds the decoded value
+            HAS_SCALAR = 0x04,
+            /// _value holds the bytes of the source document
+            RAW_TEXT = 0x08,
+            /// The value and everything below it were frozen, see freeze
+            FROZEN = 0x10,
+            /// _scalar holds an integer above the signed range in u64
+            UNSIGNED = 0x20,
+        };
+
+    private:
+        friend class Document;
+
+        void writeText() const;
+
+        void readScalar() const;
+
     protected:
-        /// Raw string value extracted from the .json source
-        String _value;
+        /// Binary form of scalar values
+        union Scalar
+        {
+            I64    i64;
+            U64    u64;
+            double r64;
+            bool   boolean;
+        };
+
+        /// Raw string value extracted from the .json source, or the
+        /// string form of _scalar once it has been requested
+        mutable String _value;
+
+        /// Decoded value for the scalar types
+        mutable Scalar _scalar;
 
         /// Holder for the class type code
         const ClassType _type;
 
+        /// Holder for the Flags bits
+        mutable U8 _flags;
+
+        /// <returns>_scalar, decoding it first if it was deferred by setRaw.</returns>
+        const Scalar& scalar() const;
+
         /// <summary>
         /// Primary constructor, protected to prevent calling it directly.
         /// </summary>
         /// <param name="type"></param>
         explicit Type(const ClassType& type) :
-            _type(type)
+            _scalar({}),
+            _type(type),
+            _flags(HAS_TEXT | HAS_SCALAR)
         {
         }
 
@@ -78,100 +125,165 @@ namespace Rt2::Json
         /// Default constructor, protected to prevent calling it directly.
         /// </summary>
         Type() :
-            _type(UNDEFINED)
+            _scalar({}),
+            _type(UNDEFINED),
+            _flags(HAS_TEXT | HAS_SCALAR)
         {
         }
 
+        /// <summary>
+        /// Called after _value is assigned.
+        /// </summary>
         virtual void notifyStringChanged()
         {
         }
 
+        /// <summary>
+        /// Called after _scalar is assigned. The string form is rebuilt on
+        /// the next call to string().
+        /// </summary>
         virtual void notifyValueChanged()
+        {
+            _flags = (_flags | HAS_SCALAR) & ~(HAS_TEXT | RAW_TEXT | UNSIGNED | FROZEN);
+        }
+
+        /// <summary>
+        /// Moves the heap allocated children of a container into dest and
+        /// empties the container. Children owned by a Document are dropped.
+        /// </summary>
+        virtual void detach(Array<Type*>&)
         {
         }
 
+        /// <summary>
+        /// Deletes every heap allocated type in the stack and below it.
+        /// </summary>
+        /// <remarks>
+        /// Children are moved onto the stack with detach before their parent
+        /// is deleted, so destroying a deep tree does not recurse.
+        /// </remarks>
+        static void releaseAll(Array<Type*>& stack);
+
     public:
         virtual ~Type() = default;
 
+        /// <summary>
+        /// Deletes the type unless it is owned by a Document.
+        /// </summary>
+        /// <param name="type">The type to release, may be null</param>
+        static void release(Type* type);
+
+        /// <returns>true if the type is owned by a Document's arena</returns>
+        bool isArenaAllocated() const;
+
+        /// <summary>
+        /// Fills every deferred value in this type and everything below it,
+        /// so that no const accessor modifies the tree afterwards.
+        /// </summary>
+        /// <remarks>
+        /// Once frozen, any number of threads may read the tree through const
+        /// pointers without synchronization. The tree must not be modified
+        /// while it is shared. After a change, freeze the tree again before
+        /// sharing it, every node is visited each time.
+        /// </remarks>
+        void freeze();
+
+        /// <returns>
+        /// true if freeze reached this type and it has not been modified
+        /// since. Changes to a child do not clear the flag of its parents.
+        /// </returns>
+        bool isFrozen() const;
+
         /// <summary>
         /// Explicitly set the internal string from a memory string
         /// </summary>
         /// <param name="mem">The value to assign to the internal string.</param>
-        void setValue(const String& mem);
+        void setValue(const StringView& mem);
+
+        /// <summary>
+        /// Keeps the source text of a scalar without decoding it.
+        /// </summary>
+        /// <param name="mem">The bytes of the value in the source document.</param>
+        /// <remarks>
+        /// The value is decoded the first time a typed accessor is called,
+        /// and toString writes these bytes until the value is reassigned.
+        /// </remarks>
+        void setRaw(const StringView& mem);
 
         /// Provides access to the underlying value as a string.
+        /// For values assigned in binary form it is built on first use.
         const String& string() const;
 
-        /// Converts the underlying string to an integer or returns the default
-        /// parameter if the internal type is not a INTEGER.
+        /// Returns the decoded integer or the default parameter
+        /// if the internal type is not a INTEGER.
         I16 i16(const I16 defaultValue = -1) const
         {
             if (_type == INTEGER)
-                return Char::toInt16(_value, defaultValue);
+                return (I16)scalar().i64;
             return defaultValue;
         }
 
-        /// Converts the underlying string to an integer or returns the default
-        /// parameter if the internal type is not a INTEGER.
+        /// Returns the decoded integer or the default parameter
+        /// if the internal type is not a INTEGER.
         I32 i32(const I32 defaultValue = -1) const
         {
             if (_type == INTEGER)
-                return Char::toInt32(_value, defaultValue);
+                return (I32)scalar().i64;
             return defaultValue;
         }
 
-        /// Converts the underlying string to an integer or returns the default
-        /// parameter if the internal type is not a INTEGER.
+        /// Returns the decoded integer or the default parameter
+        /// if the internal type is not a INTEGER.
         I64 i64(const I64 defaultValue = -1) const
         {
             if (_type == INTEGER)
-                return Char::toInt64(_value, defaultValue);
+                return (I64)scalar().i64;
             return defaultValue;
         }
 
-        /// Converts the underlying string to an integer or returns the default
-        /// parameter if the internal type is not a INTEGER.
+        /// Returns the decoded integer or the default parameter
+        /// if the internal type is not a INTEGER.
         U16 u16(const U16 defaultValue = -1) const
         {
             if (_type == INTEGER)
-                return Char::toUint16(_value, defaultValue);
+                return (U16)scalar().u64;
             return defaultValue;
         }
 
-        /// Converts the underlying string to an integer or returns the default
-        /// parameter if the internal type is not a INTEGER.
+        /// Returns the decoded integer or the default parameter
+        /// if the internal type is not a INTEGER.
         U32 u32(const U32 defaultValue = -1) const
         {
             if (_type == INTEGER)
-                return Char::toUint32(_value, defaultValue);
+                return (U32)scalar().u64;
             return defaultValue;
         }
 
-        /// Converts the underlying string to an integer or returns the default
-        /// parameter if the internal type is not a INTEGER.
+        /// Returns the decoded integer or the default parameter
+        /// if the internal type is not a INTEGER.
         U64 u64(const U64 defaultValue = -1) const
         {
             if (_type == INTEGER)
-                return Char::toUint64(_value, defaultValue);
+                return (U64)scalar().u64;
             return defaultValue;
         }
 
-        /// Converts the underlying string to an double or returns the default
-        /// parameter if the internal type is not a DOUBLE.
+        /// Returns the decoded double or the default parameter
+        /// if the internal type is not a DOUBLE.
         double r64(const double defaultValue = 0.0) const
         {
             if (_type == DOUBLE)
-                return Char::toDouble(_value);
+                return scalar().r64;
             return defaultValue;
         }
 
-        /// \brief Converts the underlying string to a bool.
+        /// \brief Returns the decoded bool.
         ///
         /// Returns the default parameter if the internal type is not a BOOLEAN.
         bool boolean(const bool defaultValue = false) const
         {
             if (_type == BOOLEAN)
-                return Char::toBool(_value);
+                return scalar().boolean;
             return defaultValue;
         }
 
@@ -181,12 +293,24 @@ namespace Rt2::Json
         /// <returns>skJsonArray or null if the type is not an array</returns>
         ArrayType* asArray();
 
+        /// <summary>
+        /// Attempts to cast to an array
+        /// </summary>
+        /// <returns>skJsonArray or null if the type is not an array</returns>
+        const ArrayType* asArray() const;
+
         /// <summary>
         /// Attempts to cast to an object
         /// </summary>
         /// <returns>skJsonObject or null if the type is not an object</returns>
         ObjectType* asObject();
 
+        /// <summary>
+        /// Attempts to cast to an object
+        /// </summary>
+        /// <returns>skJsonObject or null if the type is not an object</returns>
+        const ObjectType* asObject() const;
+
         /// <returns>true if the type is a string</returns>
         bool isString() const;
 
@@ -239,9 +363,34 @@ namespace Rt2::Json
 
     inline const String& Type::string() const
     {
+        if (!(_flags & HAS_TEXT))
+            writeText();
         return _value;
     }
 
+    inline void Type::release(Type* type)
+    {
+        if (type && !type->isArenaAllocated())
+            delete type;
+    }
+
+    inline const Type::Scalar& Type::scalar() const
+    {
+        if (!(_flags & HAS_SCALAR))
+            readScalar();
+        return _scalar;
+    }
+
+    inline bool Type::isArenaAllocated() const
+    {
+        return (_flags & ARENA) != 0;
+    }
+
+    inline bool Type::isFrozen() const
+    {
+        return (_flags & FROZEN) != 0;
+    }
+
     inline bool Type::isString() const
     {
         return _type == STRING;
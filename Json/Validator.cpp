@@ -0,0 +1,301 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cctype>
+#include "Json/Validator.h"
+#include "Json/Number.h"
+
+namespace Rt2::Json
+{
+    Validator::Validator(const char* src, const size_t len) :
+        _first(src),
+        _cur(src),
+        _end(src + len),
+        _findString(Simd::stringScanner())
+    {
+    }
+
+    size_t Validator::validate(const char* src, const size_t sizeInBytes)
+    {
+        if (!src)
+            return 0;
+        Validator validator(src, sizeInBytes);
+        return validator.run();
+    }
+
+    void Validator::skipSpace()
+    {
+        while (_cur < _end && (*_cur == ' ' || *_cur == '\n' || *_cur == '\r' || *_cur == '\t'))
+            ++_cur;
+    }
+
+    bool Validator::literal(const char* word, const size_t len)
+    {
+        if ((size_t)(_end - _cur) < len || memcmp(_cur, word, len) != 0)
+            return false;
+        _cur += len;
+        return true;
+    }
+
+    bool Validator::number()
+    {
+        const char*     start = _cur;
+        Number::Decimal dec;
+        if (!Number::scan(_cur, _end, dec))
+        {
+            _cur = start;
+            return false;
+        }
+        return true;
+    }
+
+    const char* Validator::findInvalidUtf8(const char* first, const char* last)
+    {
+        while (first < last)
+        {
+            // skip runs of ASCII eight bytes at a time
+            while (last - first >= 8)
+            {
+                U64 chunk;
+                memcpy(&chunk, first, 8);
+                if (chunk & 0x8080808080808080)
+                    break;
+                first += 8;
+            }
+            if (first >= last)
+                break;
+
+            const U8 lead = (U8)*first;
+            if (lead < 0x80)
+            {
+                ++first;
+                continue;
+            }
+
+            // The second byte range excludes overlong forms, surrogates
+            // and code points above U+10FFFF.
+            size_t count;
+            U8     lo = 0x80, hi = 0xBF;
+            if (lead >= 0xC2 && lead <= 0xDF)
+                count = 2;
+            else if (lead >= 0xE0 && lead <= 0xEF)
+            {
+                count = 3;
+                if (lead == 0xE0)
+                    lo = 0xA0;
+                else if (lead == 0xED)
+                    hi = 0x9F;
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+            {
+                count = 4;
+                if (lead == 0xF0)
+                    lo = 0x90;
+                else if (lead == 0xF4)
+                    hi = 0x8F;
+            }
+            else
+                return first;
+
+            if ((size_t)(last - first) < count)
+                return first;
+
+            if ((U8)first[1] < lo || (U8)first[1] > hi)
+                return first;
+            for (size_t i = 2; i < count; ++i)
+            {
+                if (((U8)first[i] & 0xC0) != 0x80)
+                    return first;
+            }
+            first += count;
+        }
+        return last;
+    }
+
+    bool Validator::escape()
+    {
+        // _cur is on the character that follows the backslash
+        if (_cur >= _end)
+            return false;
+
+        switch (*_cur)
+        {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+            ++_cur;
+            return true;
+        case 'u':
+            ++_cur;
+            for (int i = 0; i < 4; ++i, ++_cur)
+            {
+                if (_cur >= _end || !isxdigit((U8)*_cur))
+                    return false;
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool Validator::string()
+    {
+        // _cur is the first character after the opening quote
+        while (_cur < _end)
+        {
+            const char* stop = _findString(_cur, _end, _end);
+
+            if (const char* bad = findInvalidUtf8(_cur, stop); bad != stop)
+            {
+                _cur = bad;
+                return false;
+            }
+
+            _cur = stop;
+            if (_cur >= _end)
+                break;
+
+            if (*_cur == '"')
+            {
+                ++_cur;
+                return true;
+            }
+            if (*_cur != '\\')
+                return false;  // an unescaped control character
+
+            ++_cur;
+            if (!escape())
+                return false;
+        }
+        return false;
+    }
+
+    bool Validator::scalar()
+    {
+        switch (*_cur)
+        {
+        case '"':
+            ++_cur;
+            return string();
+        case 't':
+            return literal("true", 4);
+        case 'f':
+            return literal("false", 5);
+        case 'n':
+            return literal("null", 4);
+        default:
+            return number();
+        }
+    }
+
+    size_t Validator::run()
+    {
+        // bit n is set when the container at depth n is an object
+        U64   objects[MaxDepth / 64] = {};
+        U32   depth                  = 0;
+        State state                  = ST_VALUE;
+
+        skipSpace();
+
+        while (_cur < _end)
+        {
+            switch (state)
+            {
+            case ST_KEY:
+                if (*_cur != '"')
+                    return offset();
+                ++_cur;
+                if (!string())
+                    return offset();
+
+                skipSpace();
+                if (_cur >= _end || *_cur != ':')
+                    return offset();
+                ++_cur;
+                state = ST_VALUE;
+                break;
+            case ST_VALUE:
+                if (*_cur == '{' || *_cur == '[')
+                {
+                    if (depth >= MaxDepth)
+                        return offset();
+
+                    const bool object = *_cur == '{';
+                    const U64  bit    = (U64)1 << (depth % 64);
+                    if (object)
+                        objects[depth / 64] |= bit;
+                    else
+                        objects[depth / 64] &= ~bit;
+                    ++depth;
+                    ++_cur;
+
+                    skipSpace();
+                    if (_cur < _end && *_cur == (object ? '}' : ']'))
+                    {
+                        ++_cur;
+                        --depth;
+                        state = ST_NEXT;
+                    }
+                    else
+                        state = object ? ST_KEY : ST_VALUE;
+                }
+                else
+                {
+                    if (!scalar())
+                        return offset();
+                    state = ST_NEXT;
+                }
+                break;
+            case ST_NEXT:
+            {
+                if (depth == 0)
+                    return offset();  // characters after the value
+
+                const U32  top    = depth - 1;
+                const bool object = (objects[top / 64] >> (top % 64)) & 1;
+                if (*_cur == ',')
+                {
+                    ++_cur;
+                    state = object ? ST_KEY : ST_VALUE;
+                }
+                else if (*_cur == (object ? '}' : ']'))
+                {
+                    ++_cur;
+                    --depth;
+                }
+                else
+                    return offset();
+                break;
+            }
+            }
+            skipSpace();
+        }
+
+        if (state == ST_NEXT && depth == 0)
+            return Npos;
+        return offset();
+    }
+}  // namespace Rt2::Json
@@ -0,0 +1,109 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#pragma once
+
+#include "Json/Parser.h"
+#include "Json/Simd.h"
+#include "Utils/String.h"
+
+namespace Rt2::Json
+{
+    /// \ingroup Json
+    ///
+    /// Checks that memory holds exactly one well-formed json value without
+    /// building anything.
+    ///
+    /// The grammar is RFC 8259. Comments are not accepted, the top level
+    /// value may be of any type, and string bytes must be valid UTF-8.
+    /// Nesting is tracked in a fixed bit stack, so validation never
+    /// allocates. Documents nested deeper than MaxDepth are rejected.
+    class Validator
+    {
+    public:
+        /// <summary>
+        /// The maximum number of objects and arrays that may be open at once.
+        /// </summary>
+        static constexpr U32 MaxDepth = Parser::DefaultMaxDepth;
+
+    private:
+        enum State
+        {
+            ST_VALUE,
+            ST_KEY,
+            ST_NEXT,
+        };
+
+        const char*          _first;
+        const char*          _cur;
+        const char*          _end;
+        Simd::StringFunction _findString;
+
+        Validator(const char* src, size_t len);
+
+        size_t run();
+
+        void skipSpace();
+
+        bool string();
+
+        bool escape();
+
+        bool number();
+
+        bool literal(const char* word, size_t len);
+
+        bool scalar();
+
+        size_t offset() const;
+
+        static const char* findInvalidUtf8(const char* first, const char* last);
+
+    public:
+        /// <summary>
+        /// Validates memory as json.
+        /// </summary>
+        /// <param name="src">Memory source</param>
+        /// <param name="sizeInBytes">The size of the source memory in bytes</param>
+        /// <returns>
+        /// Npos if the memory is valid, otherwise the byte offset of the
+        /// first error. An offset equal to sizeInBytes means the input
+        /// ended early.
+        /// </returns>
+        static size_t validate(const char* src, size_t sizeInBytes);
+
+        /// <summary>
+        /// Validates a string as json.
+        /// </summary>
+        /// <returns>Npos if the string is valid, otherwise the byte offset of the first error.</returns>
+        static size_t validate(const String& src);
+    };
+
+    inline size_t Validator::offset() const
+    {
+        return (size_t)(_cur - _first);
+    }
+
+    inline size_t Validator::validate(const String& src)
+    {
+        return validate(src.c_str(), src.size());
+    }
+}  // namespace Rt2::Json
@@ -21,13 +21,30 @@
 */
 #pragma once
 
+#include "Json/Token.h"
 #include "Utils/String.h"
 
 namespace Rt2::Json
 {
+    /// <summary>
+    /// Tells the parser how to continue after a callback.
+    /// </summary>
+    enum VisitAction
+    {
+        /// Parse and report the value
+        VA_CONTINUE,
+        /// Pass over the value without reporting any part of it
+        VA_SKIP,
+        /// End the parse, parseError is not called
+        VA_STOP,
+    };
 
     /// \ingroup Json
     ///
+    /// The callbacks receive their text as a StringView into the source
+    /// buffer. Earlier versions passed a const String&; a subclass that
+    /// still overrides with that signature hides the callback instead of
+    /// overriding it and is never called, so mark overrides `override`.
     class Visitor
     {
     public:
@@ -57,18 +74,46 @@ namespace Rt2::Json
         {
         }
 
+        /// <summary>
+        /// Called with each member's key before its value is parsed.
+        /// </summary>
+        /// <param name="key">The member's key</param>
+        /// <returns>
+        /// VA_SKIP passes over the value, so no callbacks are made for it
+        /// and keyValueParsed is not called for the member. A skipped
+        /// object or array is not tokenized, see Scanner::skip.
+        /// </returns>
+        virtual VisitAction keyParsed(const StringView& key)
+        {
+            return VA_CONTINUE;
+        }
+
         /// <summary>
         ///
         /// </summary>
         /// <param name="key"></param>
         /// <param name="valueType"></param>
         /// <param name="value"></param>
-        virtual void keyValueParsed(const String&    key,
-                                    const TokenType& valueType,
-                                    const String&    value)
+        virtual void keyValueParsed(const StringView& key,
+                                    const TokenType&  valueType,
+                                    const StringView& value)
         {
         }
 
+        /// <summary>
+        /// Called instead of keyValueParsed for integers that the scanner
+        /// decoded while scanning them.
+        /// </summary>
+        /// <param name="key">The member's key</param>
+        /// <param name="value">The source text of the integer</param>
+        /// <param name="integer">The decoded integer</param>
+        virtual void keyIntegerParsed(const StringView& key,
+                                      const StringView& value,
+                                      const I64&        integer)
+        {
+            keyValueParsed(key, JT_INTEGER, value);
+        }
+
         /// <summary>
         ///
         /// </summary>
@@ -101,7 +146,7 @@ namespace Rt2::Json
         ///
         /// </summary>
         /// <param name="value"></param>
-        virtual void stringParsed(const String& value)
+        virtual void stringParsed(const StringView& value)
         {
         }
 
@@ -109,15 +154,26 @@ namespace Rt2::Json
         ///
         /// </summary>
         /// <param name="value"></param>
-        virtual void integerParsed(const String& value)
+        virtual void integerParsed(const StringView& value)
+        {
+        }
+
+        /// <summary>
+        /// Called instead of integerParsed for integers that the scanner
+        /// decoded while scanning them.
+        /// </summary>
+        /// <param name="value">The source text of the integer</param>
+        /// <param name="integer">The decoded integer</param>
+        virtual void integerValueParsed(const StringView& value, const I64& integer)
         {
+            integerParsed(value);
         }
 
         /// <summary>
         ///
         /// </summary>
         /// <param name="value"></param>
-        virtual void doubleParsed(const String& value)
+        virtual void doubleParsed(const StringView& value)
         {
         }
 
@@ -125,7 +181,7 @@ namespace Rt2::Json
         ///
         /// </summary>
         /// <param name="value"></param>
-        virtual void booleanParsed(const String& value)
+        virtual void booleanParsed(const StringView& value)
         {
         }
 
@@ -133,7 +189,7 @@ namespace Rt2::Json
         ///
         /// </summary>
         /// <param name="value"></param>
-        virtual void pointerParsed(const String& value)
+        virtual void pointerParsed(const StringView& value)
         {
         }
 
@@ -1,10 +1,32 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+#include <random>
+#include <thread>
 #include "Json/ArrayType.h"
+#include "Json/BoolType.h"
+#include "Json/Document.h"
+#include "Json/DoubleType.h"
+#include "Json/IntegerType.h"
+#include "Json/KeyTable.h"
+#include "Json/Lazy.h"
+#include "Json/NdJsonReader.h"
+#include "Json/Number.h"
 #include "Json/ObjectType.h"
+#include "Json/ParallelParser.h"
 #include "Json/Parser.h"
+#include "Json/PointerType.h"
 #include "Json/Printer.h"
+#include "Json/Projection.h"
 #include "Json/Scanner.h"
+#include "Json/Simd.h"
+#include "Json/StreamParser.h"
+#include "Json/Tape.h"
 #include "Json/Token.h"
 #include "Json/Type.h"
+#include "Json/Validator.h"
+#include "Json/Visitor.h"
 #include "TestConfig.h"
 #include "gtest/gtest.h"
 
@@ -433,3 +455,1617 @@ GTEST_TEST(Parser, Empty)
     EXPECT_EQ(b->type(), Type::ARRAY);
 
 }
+
+GTEST_TEST(Scanner, Open_LargeFile)
+{
+    // larger than the old 64K limit
+    const Rt2::String path = (std::filesystem::temp_directory_path() / "JsonLargeFile.json").string();
+
+    Rt2::String text = "[";
+    for (int i = 0; i < 20000; ++i)
+    {
+        if (i > 0)
+            text.append(", ");
+        text.append(std::to_string(i));
+    }
+    text.append("]");
+    EXPECT_GT(text.size(), 0xFFFF);
+    {
+        Rt2::OutputFileStream ofs(path, std::ios::binary);
+        ofs.write(text.c_str(), (std::streamsize)text.size());
+    }
+
+    {
+        Parser parser;
+        Type*  type = parser.parse(path);
+        EXPECT_NE(type, nullptr);
+        EXPECT_TRUE(type->isArray());
+
+        ArrayType* arr = type->asArray();
+        EXPECT_EQ(20000, arr->size());
+        EXPECT_EQ(0, arr->i32(0));
+        EXPECT_EQ(12345, arr->i32(12345));
+        EXPECT_EQ(19999, arr->i32(19999));
+    }
+    std::filesystem::remove(path);
+}
+
+GTEST_TEST(Scanner, Borrow_001)
+{
+    // Only the first 9 bytes are the document, the rest must never be read
+    const char text[] = R"([1,"a",2]tru)";
+
+    Scanner scanner;
+    scanner.borrow(text, 9);
+    EXPECT_TRUE(scanner.isOpen());
+
+    Token tok;
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_L_BRACE);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_INTEGER);
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_STRING);
+    EXPECT_TRUE(tok.value() == "a");
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_INTEGER);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_R_BRACE);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_NULL);
+    EXPECT_TRUE(tok.value().empty());
+
+    // a truncated literal at the end of an unpadded buffer is an error
+    scanner.borrow(text + 9, 3);
+    scanner.scan(tok);
+    EXPECT_FALSE(scanner.isOpen());
+
+    Rt2::String padded = R"({"a":[true,false,null]})";
+    const size_t len   = padded.size();
+    padded.resize(len + Scanner::Padding, ' ');
+
+    Parser parser;
+    Type*  type = parser.parse(padded.c_str(), len, Scanner::Padding);
+    EXPECT_NE(type, nullptr);
+    EXPECT_TRUE(type->isObject());
+    EXPECT_EQ(3, type->asObject()->find("a")->asArray()->size());
+}
+
+GTEST_TEST(Token, Token_Span)
+{
+    const char text[] = "Hello World!";
+
+    Token tok;
+    tok.setSpan(text, 5);
+    EXPECT_TRUE(tok.view() == "Hello");
+    EXPECT_EQ(tok.view().data(), text);
+    EXPECT_TRUE(tok.value() == "Hello");
+    // copied once, later views use the copy
+    EXPECT_NE(tok.view().data(), text);
+    EXPECT_EQ(tok.view().data(), tok.value().c_str());
+
+    tok.push('!');
+    EXPECT_TRUE(tok.view() == "Hello!");
+    EXPECT_NE(tok.view().data(), text);
+
+    tok.clear();
+    EXPECT_TRUE(tok.view().empty());
+}
+
+GTEST_TEST(Scanner, Escape_001)
+{
+    const Rt2::String text = R"(["plain", "a\"b\\c\/d\n", "A\u00e9\u20AC\ud83d\ude00", "\ud83d"])";
+
+    Scanner scanner;
+    scanner.borrow(text.c_str(), text.size());
+
+    Token tok;
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_STRING);
+    EXPECT_TRUE(tok.view() == "plain");
+    // unescaped strings reference the source
+    EXPECT_EQ(tok.view().data(), text.c_str() + 2);
+
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_STRING);
+    EXPECT_TRUE(tok.view() == "a\"b\\c/d\n");
+
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_STRING);
+    EXPECT_TRUE(tok.view() == "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+
+    // lone surrogate
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_FALSE(scanner.isOpen());
+}
+
+GTEST_TEST(Parser, Escape_Reflection)
+{
+    const Rt2::String text = R"({"k\"ey": ["tab\there", "quote\"", "nl\n"]})";
+
+    Parser parser;
+    Type*  type = parser.parse(text.c_str(), text.size());
+    EXPECT_NE(type, nullptr);
+
+    ObjectType* obj = type->asObject();
+    EXPECT_TRUE(obj->hasKey("k\"ey"));
+    ArrayType* arr = obj->find("k\"ey")->asArray();
+    EXPECT_TRUE(arr->at(0)->string() == "tab\there");
+    EXPECT_TRUE(arr->at(1)->string() == "quote\"");
+    EXPECT_TRUE(arr->at(2)->string() == "nl\n");
+
+    const Rt2::String out = type->toString();
+    EXPECT_TRUE(out == R"({"k\"ey":["tab\there","quote\"","nl\n"]})");
+}
+
+static void ScanAll(const Rt2::String& text, const size_t threshold, std::vector<Rt2::String>& dest)
+{
+    Scanner scanner;
+    scanner.setIndexThreshold(threshold);
+    scanner.borrow(text.c_str(), text.size());
+
+    Token tok;
+    for (;;)
+    {
+        scanner.scan(tok);
+        dest.push_back(std::to_string(tok.type()) + ":" + Rt2::String(tok.view()));
+        if (!scanner.isOpen() || (tok.type() == JT_NULL && tok.view().empty()))
+            break;
+    }
+
+    dest.push_back(scanner.isOpen() ? "open" : "closed");
+}
+
+GTEST_TEST(Scanner, StructuralIndex_001)
+{
+    const char* pieces[] = {
+        "{", "}", "[", "]", ":", ",", " ", "\n", "\t", "  ",
+        "\"abc\"", "\"a\\\"b\"", "\"\\\\\"", "\"\\\\\\\"\"", "\"x\\\\\\\\\"",
+        "\"{[,:]}\"", "123", "-4.5", "true", "false", "null", "// note\n",
+        "\"/* not a comment */\"", "truex", "@",
+    };
+    const size_t count = sizeof pieces / sizeof pieces[0];
+
+    Rt2::U32 seed = 7;
+    for (int round = 0; round < 400; ++round)
+    {
+        Rt2::String text;
+        for (int i = 0; i < 60; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            text.append(pieces[(seed >> 16) % count]);
+        }
+
+        std::vector<Rt2::String> byteScan, indexScan;
+        ScanAll(text, Rt2::Npos, byteScan);
+        ScanAll(text, 0, indexScan);
+        EXPECT_EQ(byteScan, indexScan) << text;
+    }
+}
+
+GTEST_TEST(Scanner, StructuralIndex_Kernels)
+{
+    Rt2::String text;
+    for (int i = 0; i < 256; ++i)
+        text.push_back((char)i);
+    text.append(R"({"a\\":[1, 2,"\"x"]}, "y\\\"" :  ,)");
+
+    const BlockMasks* expected = nullptr;
+    BlockMasks        masks[4];
+
+    const Simd::Kernel kernels[] = {Simd::SCALAR, Simd::SSE2, Simd::AVX2, Simd::NEON};
+    for (size_t offset = 0; offset + 64 <= text.size(); offset += 16)
+    {
+        expected = nullptr;
+        for (int k = 0; k < 4; ++k)
+        {
+            if (!Simd::supports(kernels[k]))
+                continue;
+            Simd::classifier(kernels[k])(text.c_str() + offset, masks[k]);
+
+            if (expected)
+            {
+                EXPECT_EQ(expected->quote, masks[k].quote);
+                EXPECT_EQ(expected->backslash, masks[k].backslash);
+                EXPECT_EQ(expected->space, masks[k].space);
+                EXPECT_EQ(expected->op, masks[k].op);
+                EXPECT_EQ(expected->slash, masks[k].slash);
+            }
+            else
+                expected = &masks[k];
+        }
+    }
+}
+
+GTEST_TEST(Scanner, StringKernels)
+{
+    Rt2::String text;
+    Rt2::U32    seed = 11;
+    for (int i = 0; i < 4096; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+
+        // mostly plain characters with the occasional stop character
+        const Rt2::U32 r = (seed >> 16) % 64;
+        if (r == 0)
+            text.push_back('"');
+        else if (r == 1)
+            text.push_back('\\');
+        else if (r == 2)
+            text.push_back((char)(r * 7 % 32));
+        else
+            text.push_back((char)(0x20 + (seed >> 8) % 0xE0));
+    }
+
+    const char* end = text.c_str() + text.size();
+
+    const Simd::Kernel kernels[] = {Simd::SSE2, Simd::AVX2, Simd::NEON};
+    for (const Simd::Kernel kernel : kernels)
+    {
+        if (!Simd::supports(kernel))
+            continue;
+
+        const Simd::StringFunction scalar = Simd::stringScanner(Simd::SCALAR);
+        const Simd::StringFunction vector = Simd::stringScanner(kernel);
+        for (const char* first = text.c_str(); first < end; ++first)
+        {
+            for (const char* last : {end, Rt2::Min(end, first + 5), Rt2::Min(end, first + 40)})
+            {
+                EXPECT_EQ(scalar(first, last, last), vector(first, last, last));
+                EXPECT_EQ(scalar(first, last, end), vector(first, last, end));
+            }
+        }
+    }
+}
+
+GTEST_TEST(Scanner, String_Long)
+{
+    Rt2::String body;
+    for (int i = 0; i < 1000; ++i)
+        body.push_back((char)('a' + i % 26));
+
+    const Rt2::String text = "[\"" + body + "\", \"" + body + "\\n" + body + "\", \"tab\there\"]";
+
+    Scanner scanner;
+    scanner.borrow(text.c_str(), text.size());
+
+    Token tok;
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_STRING);
+    EXPECT_TRUE(tok.view() == body);
+
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_STRING);
+    EXPECT_TRUE(tok.view() == body + "\n" + body);
+
+    // raw control characters must be escaped
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_FALSE(scanner.isOpen());
+}
+
+static Type* FeedChunks(StreamParser& parser, const Rt2::String& text, const size_t chunk)
+{
+    parser.reset();
+    for (size_t i = 0; i < text.size(); i += chunk)
+    {
+        if (!parser.feed(text.c_str() + i, std::min(chunk, text.size() - i)))
+            return nullptr;
+    }
+    return parser.finish();
+}
+
+GTEST_TEST(StreamParser, Chunks_001)
+{
+    std::ifstream     in(MakeTestFile("test3.json"), std::ios::binary);
+    const Rt2::String text{std::istreambuf_iterator(in), std::istreambuf_iterator<char>()};
+    EXPECT_FALSE(text.empty());
+
+    for (const size_t chunk : {1, 7, 64, 0x10000})
+    {
+        StreamParser parser;
+        Type*        nObj = FeedChunks(parser, text, chunk);
+        EXPECT_NE(nObj, nullptr);
+        EXPECT_TRUE(nObj->isArray());
+        Test3Validate(nObj->asArray());
+        EXPECT_EQ(parser.pending(), 0);
+    }
+}
+
+GTEST_TEST(StreamParser, Chunks_002)
+{
+    const Rt2::String text =
+        "// leading comment\n"
+        R"({"k\"ey": ["tab\there", "é😀", -12.5, 123456789, true, null],)"
+        R"( "nested": {"a": [], "b": {}, "c": [[1], {"d": false}]}, "last": 0})";
+
+    Parser            parser;
+    const Rt2::String expected = parser.parse(text.c_str(), text.size())->toString();
+
+    for (size_t chunk = 1; chunk < 12; ++chunk)
+    {
+        StreamParser stream;
+        Type*        nObj = FeedChunks(stream, text, chunk);
+        EXPECT_NE(nObj, nullptr);
+        EXPECT_TRUE(nObj->toString() == expected);
+    }
+
+    StreamParser stream;
+    EXPECT_TRUE(stream.feed("[1, 2", 5));
+    EXPECT_EQ(stream.pending(), 1);
+    EXPECT_FALSE(stream.done());
+    EXPECT_EQ(stream.finish(), nullptr);
+
+    stream.reset();
+    EXPECT_FALSE(stream.feed("[1 2]", 5));
+    EXPECT_TRUE(stream.failed());
+
+    stream.reset();
+    EXPECT_TRUE(stream.feed("{\"a\":\"b", 7));
+    EXPECT_EQ(stream.finish(), nullptr);
+}
+
+GTEST_TEST(StreamParser, Reset_001)
+{
+    StreamParser stream;
+
+    // stop in the middle of nested objects and arrays
+    const Rt2::String first = R"({"a":[1,{"b":[2,{"c":)";
+    EXPECT_TRUE(stream.feed(first.c_str(), first.size()));
+    EXPECT_FALSE(stream.done());
+
+    stream.reset();
+
+    const Rt2::String second = R"([{"d":[3]},4])";
+    EXPECT_TRUE(stream.feed(second.c_str(), second.size()));
+    Type* root = stream.finish();
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->toString() == second);
+
+    stream.reset();
+
+    const Rt2::String third = R"({"e":5})";
+    EXPECT_TRUE(stream.feed(third.c_str(), third.size()));
+    root = stream.finish();
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->toString() == third);
+}
+
+GTEST_TEST(Document, Parse_001)
+{
+    Document doc;
+    Type*    nObj = doc.parse(MakeTestFile("test3.json"));
+    EXPECT_NE(nObj, nullptr);
+    EXPECT_EQ(nObj, doc.root());
+    EXPECT_TRUE(nObj->isArenaAllocated());
+    EXPECT_GT(doc.bytesUsed(), 0);
+    Test3Validate(nObj->asArray());
+
+    // heap values added to arena containers are still deleted
+    nObj->asArray()->add((Rt2::I64)123);
+    EXPECT_EQ(nObj->asArray()->at(nObj->asArray()->size() - 1)->i64(), 123);
+
+    const Rt2::String text = R"({"a": [1, -7, "three", true, null], "b": {"c": {}}})";
+    nObj                   = doc.parse(text.c_str(), text.size());
+    EXPECT_NE(nObj, nullptr);
+    EXPECT_TRUE(nObj->toString() == R"({"a":[1,-7,"three",true,null],"b":{"c":{}}})") << nObj->toString();
+
+    EXPECT_EQ(doc.parse("[1, 2", 5), nullptr);
+    EXPECT_EQ(doc.root(), nullptr);
+
+    doc.clear();
+    EXPECT_EQ(doc.bytesUsed(), 0);
+}
+
+GTEST_TEST(Document, Arena_001)
+{
+    Arena arena;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto* val = (Rt2::U64*)arena.allocate(sizeof(Rt2::U64), alignof(Rt2::U64));
+        EXPECT_EQ((size_t)val % alignof(Rt2::U64), 0);
+    }
+    EXPECT_EQ(arena.used(), 10000 * sizeof(Rt2::U64));
+
+    // larger than a block
+    char* big = (char*)arena.allocate(Arena::BlockSize * 2, 64);
+    EXPECT_EQ((size_t)big % 64, 0);
+    big[Arena::BlockSize * 2 - 1] = 1;
+
+    Rt2::String* str = arena.create<Rt2::String>(1000, 'x');
+    EXPECT_EQ(str->size(), 1000);
+    arena.clear();
+    EXPECT_EQ(arena.used(), 0);
+}
+
+GTEST_TEST(Tape, Parse_001)
+{
+    Tape tape;
+    EXPECT_TRUE(tape.parse(MakeTestFile("test4.json")));
+
+    const TapeArray arr = tape.root().asArray();
+    EXPECT_TRUE(arr.valid());
+    EXPECT_EQ(7, arr.size());
+    for (int i = 0; i < 6; ++i)
+        EXPECT_EQ(i, arr.at(i).i16());
+    EXPECT_TRUE(arr.at(6).string() == "Hello");
+    EXPECT_FALSE(arr.at(7).valid());
+
+    Parser parser;
+    Type*  nObj = parser.parse(MakeTestFile("test3.json"));
+    EXPECT_TRUE(tape.parse(MakeTestFile("test3.json")));
+    EXPECT_TRUE(tape.root().toString() == nObj->toString());
+}
+
+GTEST_TEST(Tape, Parse_002)
+{
+    const Rt2::String text = R"({"a": [1, -2.5, "th\"ree", true, null, [], {}],)"
+                             R"( "b": {"c": {"d": false}}, "big": 123456789012, "e": "x"})";
+
+    Tape tape;
+    EXPECT_TRUE(tape.parse(text.c_str(), text.size()));
+
+    const TapeObject obj = tape.root().asObject();
+    EXPECT_TRUE(obj.valid());
+    EXPECT_FALSE(tape.root().asArray().valid());
+    EXPECT_EQ(obj.size(), 4);
+    EXPECT_TRUE(obj.hasKey("big"));
+    EXPECT_FALSE(obj.hasKey("z"));
+    EXPECT_EQ(obj.integer("big"), 123456789012);
+    EXPECT_TRUE(obj.string("e") == "x");
+    EXPECT_FALSE(obj.find("b").asObject().find("c").asObject().boolean("d", true));
+
+    const TapeArray arr = obj.find("a").asArray();
+    EXPECT_EQ(arr.size(), 7);
+    EXPECT_EQ(arr.at(0).type(), Type::INTEGER);
+    EXPECT_DOUBLE_EQ(arr.at(1).r64(), -2.5);
+    EXPECT_EQ(arr.at(1).i64(), -1);
+    EXPECT_TRUE(arr.at(2).string() == "th\"ree");
+    EXPECT_TRUE(arr.at(3).boolean());
+    EXPECT_TRUE(arr.at(4).isNull());
+    EXPECT_EQ(arr.at(5).asArray().size(), 0);
+    EXPECT_EQ(arr.at(6).asObject().size(), 0);
+
+    // keys are visited in document order
+    Rt2::String keys;
+    for (const auto& [key, value] : obj)
+        keys.append(key);
+    EXPECT_TRUE(keys == "abbige");
+
+    EXPECT_FALSE(tape.parse("[1, 2", 5));
+    EXPECT_FALSE(tape.root().valid());
+    EXPECT_FALSE(tape.parse("{\"a\" 1}", 7));
+    EXPECT_FALSE(tape.parse("[1 2]", 5));
+    EXPECT_TRUE(tape.parse("[1, 2,]", 7));
+}
+
+GTEST_TEST(Tape, Unsigned_001)
+{
+    const Rt2::String text = "[18446744073709551615, 9223372036854775808, -5, 7, 18446744073709551616]";
+
+    Tape tape;
+    ASSERT_TRUE(tape.parse(text.c_str(), text.size()));
+
+    const TapeArray arr = tape.root().asArray();
+    EXPECT_EQ(arr.at(0).type(), Type::INTEGER);
+    EXPECT_EQ(arr.at(0).u64(), UINT64_MAX);
+    EXPECT_EQ(arr.at(0).i64(), -1);
+    EXPECT_EQ(arr.at(1).u64(), 9223372036854775808ull);
+    EXPECT_EQ(arr.at(2).i64(), -5);
+    EXPECT_EQ(arr.at(2).u64(), UINT64_MAX);
+    EXPECT_EQ(arr.at(2).u32(7), 7u);
+    EXPECT_EQ(arr.at(3).u32(), 7u);
+    // above the unsigned range
+    EXPECT_EQ(arr.at(4).type(), Type::DOUBLE);
+
+    EXPECT_TRUE(tape.root().toString() ==
+                "[18446744073709551615,9223372036854775808,-5,7,18446744073709551616.0]");
+}
+
+GTEST_TEST(Type, ScalarCache)
+{
+    IntegerType integer(42);
+    EXPECT_EQ(integer.i64(), 42);
+    EXPECT_EQ(integer.u16(), 42);
+    EXPECT_TRUE(integer.string() == "42");
+    EXPECT_DOUBLE_EQ(integer.r64(7.0), 7.0);
+
+    integer.setValue("18446744073709551615");
+    EXPECT_EQ(integer.u64(), 18446744073709551615ull);
+    integer.setValue("-12");
+    EXPECT_EQ(integer.i32(), -12);
+    EXPECT_TRUE(integer.string() == "-12");
+
+    DoubleType real(0.5);
+    EXPECT_DOUBLE_EQ(real.r64(), 0.5);
+    EXPECT_EQ(real.i64(3), 3);
+    EXPECT_FALSE(real.string().empty());
+
+    BoolType boolean(true);
+    EXPECT_TRUE(boolean.boolean());
+    EXPECT_TRUE(boolean.string() == "true");
+
+    PointerType null;
+    null.setValue("null");
+    EXPECT_TRUE(null.string() == "null");
+
+    Parser parser;
+    Type*  nObj = parser.parse(MakeTestFile("test4.json"));
+    EXPECT_TRUE(nObj->asArray()->at(5)->string() == "5");
+    EXPECT_EQ(nObj->asArray()->at(5)->i64(), 5);
+}
+
+GTEST_TEST(Document, LazyNumbers)
+{
+    const Rt2::String text = R"({"a": 1.50, "b": [2.000, -0.0, 12, 18446744073709551615, -0], "c": 7, "d": -0})";
+
+    Document doc;
+    doc.setLazyNumbers(true);
+    Type* nObj = doc.parse(text.c_str(), text.size());
+    EXPECT_NE(nObj, nullptr);
+
+    // untouched numbers print their source text
+    EXPECT_TRUE(nObj->toString() == R"({"a":1.50,"b":[2.000,-0.0,12,18446744073709551615,-0],"c":7,"d":-0})");
+
+    ObjectType* obj = nObj->asObject();
+    EXPECT_DOUBLE_EQ(obj->find("a")->r64(), 1.5);
+    EXPECT_TRUE(obj->find("a")->string() == "1.50");
+    EXPECT_EQ(obj->find("b")->asArray()->at(3)->u64(), 18446744073709551615ull);
+    EXPECT_EQ(obj->find("c")->i32(), 7);
+    EXPECT_EQ(obj->find("d")->i64(), 0);
+
+    IntegerType integer;
+    integer.setRaw("0012");
+    EXPECT_EQ(integer.i64(), 12);
+    EXPECT_TRUE(integer.Type::toString() == "0012");
+}
+
+static bool ParseInteger(const Rt2::String& text, Rt2::I64& dest, size_t& consumed)
+{
+    const char* cur  = text.c_str();
+    const bool  fits = Number::parseInteger(cur, text.c_str() + text.size(), dest);
+    consumed         = (size_t)(cur - text.c_str());
+    return fits;
+}
+
+GTEST_TEST(Number, ParseInteger)
+{
+    Rt2::I64 val;
+    size_t   len;
+    EXPECT_TRUE(ParseInteger("0", val, len));
+    EXPECT_EQ(val, 0);
+    EXPECT_TRUE(ParseInteger("-0", val, len));
+    EXPECT_EQ(val, 0);
+    EXPECT_TRUE(ParseInteger("12345678", val, len));
+    EXPECT_EQ(val, 12345678);
+    EXPECT_TRUE(ParseInteger("123456789012345678,", val, len));
+    EXPECT_EQ(val, 123456789012345678);
+    EXPECT_EQ(len, 18);
+    EXPECT_TRUE(ParseInteger("9223372036854775807", val, len));
+    EXPECT_EQ(val, INT64_MAX);
+    EXPECT_TRUE(ParseInteger("-9223372036854775808", val, len));
+    EXPECT_EQ(val, INT64_MIN);
+    EXPECT_FALSE(ParseInteger("9223372036854775808", val, len));
+    EXPECT_FALSE(ParseInteger("-9223372036854775809", val, len));
+    EXPECT_FALSE(ParseInteger("99999999999999999999", val, len));
+    EXPECT_EQ(len, 20);
+    EXPECT_FALSE(ParseInteger("-", val, len));
+    EXPECT_FALSE(ParseInteger("", val, len));
+    EXPECT_TRUE(ParseInteger("1234567.5", val, len));
+    EXPECT_EQ(val, 1234567);
+    EXPECT_EQ(len, 7);
+
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const Rt2::I64    expected = (Rt2::I64)(rng() >> (rng() % 64));
+        const Rt2::String text     = std::to_string(i % 2 ? -expected : expected);
+        EXPECT_TRUE(ParseInteger(text, val, len));
+        EXPECT_EQ(val, i % 2 ? -expected : expected);
+        EXPECT_EQ(len, text.size());
+    }
+}
+
+GTEST_TEST(Scanner, IntegerValue)
+{
+    const Rt2::String text = "[1234567890123, -5, 1.5, 99999999999999999999, 1e2]";
+
+    Scanner scanner;
+    scanner.borrow(text.c_str(), text.size());
+
+    Token tok;
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_TRUE(tok.hasInteger());
+    EXPECT_EQ(tok.integer(), 1234567890123);
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_TRUE(tok.hasInteger());
+    EXPECT_EQ(tok.integer(), -5);
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_NUMBER);
+    EXPECT_FALSE(tok.hasInteger());
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_INTEGER);
+    EXPECT_FALSE(tok.hasInteger());
+    scanner.scan(tok);
+    scanner.scan(tok);
+    EXPECT_EQ(tok.type(), TokenType::JT_NUMBER);
+    EXPECT_FALSE(tok.hasInteger());
+
+    Parser parser;
+    Type*  nObj = parser.parse(text.c_str(), text.size());
+    EXPECT_NE(nObj, nullptr);
+    EXPECT_EQ(nObj->asArray()->at(0)->i64(), 1234567890123);
+    EXPECT_TRUE(nObj->asArray()->at(1)->string() == "-5");
+    EXPECT_TRUE(nObj->asArray()->at(3)->isInteger());
+}
+
+static bool ParseDouble(const Rt2::String& text, double& dest)
+{
+    return Number::parseDouble(text.c_str(), text.c_str() + text.size(), dest);
+}
+
+GTEST_TEST(Number, ParseDouble)
+{
+    double val;
+    EXPECT_TRUE(ParseDouble("1e5", val));
+    EXPECT_EQ(val, 1e5);
+    EXPECT_TRUE(ParseDouble("-0.0", val));
+    EXPECT_TRUE(val == 0.0 && std::signbit(val));
+    EXPECT_TRUE(ParseDouble("1E-400", val));
+    EXPECT_EQ(val, 0.0);
+    EXPECT_TRUE(ParseDouble("-1e400", val));
+    EXPECT_EQ(val, -std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(ParseDouble("4.9e-324", val));
+    EXPECT_EQ(val, std::numeric_limits<double>::denorm_min());
+    EXPECT_TRUE(ParseDouble("2.2250738585072011e-308", val));
+    EXPECT_EQ(val, 2.2250738585072011e-308);
+    EXPECT_TRUE(ParseDouble("1.7976931348623157e308", val));
+    EXPECT_EQ(val, std::numeric_limits<double>::max());
+    EXPECT_TRUE(ParseDouble("0.1000000000000000055511151231257827021181583404541015625", val));
+    EXPECT_EQ(val, 0.1);
+    EXPECT_TRUE(ParseDouble("9007199254740993", val));
+    EXPECT_EQ(val, 9007199254740992.0);
+    EXPECT_TRUE(ParseDouble("9007199254740993.0000000000000000001", val));
+    EXPECT_EQ(val, 9007199254740994.0);
+    EXPECT_TRUE(ParseDouble("0.000000000000000000000000000000012345", val));
+    EXPECT_EQ(val, 1.2345e-32);
+
+    for (const char* bad : {"01", "1.", ".5", "-", "1e", "1e+", "+1", "1.2.3", "1-2", "--1", "1x", ""})
+        EXPECT_FALSE(ParseDouble(bad, val)) << bad;
+
+    std::mt19937_64 rng(11);
+    char            buf[64];
+    for (int i = 0; i < 100000; ++i)
+    {
+        Rt2::U64 bits = rng();
+        double   expected;
+        std::memcpy(&expected, &bits, sizeof(double));
+        if (!std::isfinite(expected))
+            continue;
+
+        snprintf(buf, sizeof buf, "%.*g", (int)(rng() % 17) + 1, expected);
+        expected = strtod(buf, nullptr);
+        EXPECT_TRUE(ParseDouble(buf, val)) << buf;
+        EXPECT_EQ(val, expected) << buf;
+    }
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        // short decimals exercise the exact and half way cases
+        snprintf(buf, sizeof buf, "%llu.%llue%d", (unsigned long long)(rng() % 100000000),
+                 (unsigned long long)(rng() % 1000), (int)(rng() % 80) - 40);
+        const double expected = strtod(buf, nullptr);
+        EXPECT_TRUE(ParseDouble(buf, val)) << buf;
+        EXPECT_EQ(val, expected) << buf;
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        // more digits than the mantissa holds, including subnormals
+        Rt2::String text = std::to_string(rng() % 9 + 1) + ".";
+        for (size_t d = rng() % 40 + 20; d > 0; --d)
+            text.push_back((char)('0' + rng() % 10));
+        text += "e" + std::to_string((int)(rng() % 660) - 330);
+
+        const double expected = strtod(text.c_str(), nullptr);
+        EXPECT_TRUE(ParseDouble(text, val)) << text;
+        EXPECT_EQ(val, expected) << text;
+    }
+}
+
+GTEST_TEST(Scanner, NumberGrammar)
+{
+    for (const char* text : {"[1e5]", "[-0.5E+3]", "[0]", "[-0]", "[12.25e-2]"})
+    {
+        Parser parser;
+        Type*  nObj = parser.parse(text, strlen(text));
+        EXPECT_NE(nObj, nullptr) << text;
+    }
+
+    for (const char* text : {"[01]", "[1.]", "[.5]", "[1-2]", "[1.2.3]", "[1e]", "[-]"})
+    {
+        Parser parser;
+        Type*  nObj = parser.parse(text, strlen(text));
+        EXPECT_EQ(nObj, nullptr) << text;
+    }
+
+    Parser parser;
+    Type*  nObj = parser.parse("[1.5e3, 2]", 10);
+    EXPECT_DOUBLE_EQ(nObj->asArray()->at(0)->r64(), 1500.0);
+    EXPECT_TRUE(nObj->asArray()->at(0)->isDouble());
+}
+
+static Rt2::String FormatDouble(const double value)
+{
+    char buf[Number::DoubleBufferSize];
+    return {buf, Number::formatDouble(value, buf)};
+}
+
+GTEST_TEST(Number, FormatDouble)
+{
+    EXPECT_TRUE(FormatDouble(1.0) == "1.0");
+    EXPECT_TRUE(FormatDouble(-0.0) == "-0.0");
+    EXPECT_TRUE(FormatDouble(0.1) == "0.1");
+    EXPECT_TRUE(FormatDouble(123456.75) == "123456.75");
+    EXPECT_TRUE(FormatDouble(1e300) == "1e+300");
+    EXPECT_TRUE(FormatDouble(std::numeric_limits<double>::quiet_NaN()) == "null");
+    EXPECT_TRUE(FormatDouble(std::numeric_limits<double>::infinity()) == "null");
+
+    std::mt19937_64 rng(13);
+    for (int i = 0; i < 100000; ++i)
+    {
+        const Rt2::U64 bits = rng();
+        double         expected;
+        std::memcpy(&expected, &bits, sizeof(double));
+        if (!std::isfinite(expected))
+            continue;
+
+        const Rt2::String text = FormatDouble(expected);
+
+        double val;
+        EXPECT_TRUE(ParseDouble(text, val)) << text;
+        EXPECT_EQ(std::memcmp(&val, &expected, sizeof(double)), 0) << text;
+    }
+
+    const Rt2::String text = R"({"a":[0.1,2.5,-1e-7,1.0,3]})";
+
+    Parser parser;
+    Type*  nObj = parser.parse(text.c_str(), text.size());
+    EXPECT_TRUE(nObj->toString() == R"({"a":[0.1,2.5,-1e-07,1.0,3]})");
+    EXPECT_TRUE(nObj->asObject()->find("a")->asArray()->at(3)->isDouble());
+    EXPECT_TRUE(DoubleType(0.3).string() == "0.3");
+}
+
+static Rt2::String FormatInteger(const Rt2::I64 value)
+{
+    char buf[Number::IntegerBufferSize];
+    return {buf, Number::formatInteger(value, buf)};
+}
+
+GTEST_TEST(Number, FormatInteger)
+{
+    EXPECT_TRUE(FormatInteger(0) == "0");
+    EXPECT_TRUE(FormatInteger(-7) == "-7");
+    EXPECT_TRUE(FormatInteger(10) == "10");
+    EXPECT_TRUE(FormatInteger(INT64_MAX) == "9223372036854775807");
+    EXPECT_TRUE(FormatInteger(INT64_MIN) == "-9223372036854775808");
+
+    char buf[Number::IntegerBufferSize];
+    EXPECT_EQ(Number::formatUnsigned(UINT64_MAX, buf), 20);
+    EXPECT_TRUE(Rt2::String(buf) == "18446744073709551615");
+
+    Rt2::U64 power = 1;
+    for (size_t digits = 1; digits < 20; ++digits, power *= 10)
+    {
+        EXPECT_EQ(Number::digitCount(power), digits);
+        EXPECT_EQ(Number::digitCount(power * 10 - 1), digits);
+    }
+
+    std::mt19937_64 rng(17);
+    for (int i = 0; i < 100000; ++i)
+    {
+        const auto value = (Rt2::I64)(rng() >> (rng() % 64));
+        EXPECT_TRUE(FormatInteger(value) == std::to_string(value));
+        EXPECT_TRUE(FormatInteger(-value) == std::to_string(-value));
+    }
+
+    ObjectType obj;
+    obj.insert("id", (Rt2::I64)1234567890123);
+    EXPECT_TRUE(obj.Type::toString() == R"({"id":1234567890123})");
+    EXPECT_TRUE(obj.find("id")->string() == "1234567890123");
+}
+
+GTEST_TEST(Number, FormatUnsigned_001)
+{
+    const Rt2::String src = R"([18446744073709551615,{"id":9223372036854775808}])";
+
+    for (const bool lazy : {false, true})
+    {
+        Document doc;
+        doc.setLazyNumbers(lazy);
+        Type* root = doc.parse(src.c_str(), src.size());
+        ASSERT_NE(root, nullptr);
+        EXPECT_TRUE(root->Type::toString() == src);
+
+        Type* max = root->asArray()->at(0);
+        EXPECT_EQ(max->u64(), UINT64_MAX);
+        EXPECT_TRUE(max->string() == "18446744073709551615");
+
+        // the string form is rebuilt from the decoded value
+        max->setValue(Rt2::String("18446744073709551615"));
+        EXPECT_TRUE(max->Type::toString() == "18446744073709551615");
+    }
+}
+
+GTEST_TEST(KeyTable, Intern_001)
+{
+    KeyTable keys;
+
+    const Symbol* a = keys.intern("id");
+    const Symbol* b = keys.intern("name");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(keys.intern("id"), a);
+    EXPECT_EQ(keys.find("name"), b);
+    EXPECT_EQ(keys.find("missing"), nullptr);
+    EXPECT_EQ(keys.size(), 2);
+
+    for (int i = 0; i < 1000; ++i)
+        keys.intern("k" + std::to_string(i));
+    EXPECT_EQ(keys.size(), 1002);
+    EXPECT_EQ(keys.find("id"), a);
+    EXPECT_TRUE(keys.find("k999")->text == "k999");
+    EXPECT_EQ(keys.at(a->id), a);
+}
+
+GTEST_TEST(KeyTable, Document_001)
+{
+    Rt2::String src = "[";
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i)
+            src.push_back(',');
+        src += R"({"id":)" + std::to_string(i) + R"(,"name":"n","tags":{"id":true}})";
+    }
+    src.push_back(']');
+
+    Document doc;
+    Type*    root = doc.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(doc.keys().size(), 3);
+
+    ArrayType*  arr = root->asArray();
+    ObjectType* a   = arr->at(0)->asObject();
+    ObjectType* b   = arr->at(99)->asObject();
+    EXPECT_EQ(a->dictionary().begin()->symbol, b->dictionary().begin()->symbol);
+    EXPECT_EQ(b->i64("id"), 99);
+    EXPECT_TRUE(b->hasKey("tags"));
+    EXPECT_FALSE(b->hasKey("missing"));
+    EXPECT_TRUE(b->find("tags")->asObject()->boolean("id"));
+    EXPECT_TRUE(a->Type::toString() == R"({"id":0,"name":"n","tags":{"id":true}})");
+
+    ObjectType standalone;
+    standalone.insert("x", (Rt2::I64)1);
+    standalone.insert("x", (Rt2::I64)2);
+    EXPECT_EQ(standalone.i64("x"), 1);
+    EXPECT_EQ(standalone.dictionary().size(), 1);
+}
+
+GTEST_TEST(KeyTable, Dictionary_001)
+{
+    KeyTable   keys;
+    ObjectType obj(&keys);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const Rt2::String key = "k" + std::to_string(i);
+        obj.insert(key, (Rt2::I64)i);
+        EXPECT_EQ(obj.dictionary().size(), (Rt2::U32)i + 1);
+
+        // every key inserted so far must survive the move off the inline storage
+        for (int j = 0; j <= i; ++j)
+            ASSERT_EQ(obj.i64("k" + std::to_string(j)), j);
+        EXPECT_FALSE(obj.hasKey("k" + std::to_string(i + 1)));
+    }
+
+    int expected = 0;
+    for (const auto& it : obj.dictionary())
+    {
+        EXPECT_TRUE(it.first == "k" + std::to_string(expected));
+        EXPECT_EQ(it.second->i64(), expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 100);
+
+    // the dictionary can still be used with String keys
+    ObjectType::Dictionary& dict = obj.dictionary();
+    EXPECT_EQ(dict.find("k42"), 42u);
+    EXPECT_EQ(dict.find("nope"), Rt2::Npos);
+    EXPECT_TRUE(dict.insert("extra", new IntegerType((Rt2::I64)7)));
+    EXPECT_FALSE(dict.insert("k0", nullptr));
+    EXPECT_EQ(obj.i64("extra"), 7);
+
+    ObjectType empty;
+    EXPECT_EQ(empty.dictionary().find("k0"), Rt2::Npos);
+}
+
+GTEST_TEST(KeyTable, Key_001)
+{
+    static constexpr Key Timestamp("timestamp");
+    static constexpr Key Missing("missing");
+    static_assert(Timestamp.hash() == KeyTable::hash("timestamp", 9));
+    static_assert(Timestamp.size() == 9);
+
+    const Rt2::String src = R"({"timestamp":1700000000123,"ok":true,"name":"abc","r":0.5})";
+
+    Document doc;
+    Type*    root = doc.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    ObjectType* obj = root->asObject();
+
+    EXPECT_TRUE(obj->hasKey(Timestamp));
+    EXPECT_FALSE(obj->hasKey(Missing));
+    EXPECT_EQ(obj->i64(Timestamp), 1700000000123);
+    EXPECT_EQ(obj->i64(Missing, 7), 7);
+    EXPECT_TRUE(obj->boolean(Key("ok")));
+    EXPECT_TRUE(obj->string(Key("name")) == "abc");
+    EXPECT_DOUBLE_EQ(obj->r64(Key("r")), 0.5);
+    EXPECT_EQ(obj->find(Timestamp), obj->find("timestamp"));
+
+    ObjectType empty;
+    EXPECT_EQ(empty.find(Timestamp), nullptr);
+    EXPECT_EQ(empty.i32(Timestamp, 3), 3);
+}
+
+GTEST_TEST(Parser, Depth_001)
+{
+    // deep enough to overflow a small thread stack with a recursive parser
+    const Rt2::String deep = Rt2::String(100000, '[') + Rt2::String(100000, ']');
+
+    Parser parser;
+    EXPECT_EQ(parser.parse(deep.c_str(), deep.size()), nullptr);
+
+    parser.setMaxDepth(200000);
+    Type* root = parser.parse(deep.c_str(), deep.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->isArray());
+
+    // the heap tree is destroyed with the parser, which must not recurse either
+    Rt2::String objects;
+    for (int i = 0; i < 100000; ++i)
+        objects += "{\"a\":";
+    objects += "1" + Rt2::String(100000, '}');
+
+    Parser nested;
+    nested.setMaxDepth(200000);
+    root = nested.parse(objects.c_str(), objects.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->isObject());
+}
+
+GTEST_TEST(Parser, Depth_002)
+{
+    const Rt2::String src = R"({"a\"b":{"c":[1,{"d":[true]}]},"e":2})";
+
+    Parser parser;
+    parser.setMaxDepth(3);
+    EXPECT_EQ(parser.parse(src.c_str(), src.size()), nullptr);
+
+    Parser nested;
+    nested.setMaxDepth(5);
+    Type* root = nested.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->Type::toString() == src);
+
+    Parser strict;
+    const Rt2::String missingComma = R"([1 2])";
+    EXPECT_EQ(strict.parse(missingComma.c_str(), missingComma.size()), nullptr);
+    const Rt2::String unterminated = R"({"a":[1,2)";
+    EXPECT_EQ(strict.parse(unterminated.c_str(), unterminated.size()), nullptr);
+}
+
+GTEST_TEST(Validator, Validate_001)
+{
+    EXPECT_EQ(Validator::validate(R"({"a":[1,-2.5e3,true,false,null,"xé\n"],"b":{}})"), Rt2::Npos);
+    EXPECT_EQ(Validator::validate(" [ ] "), Rt2::Npos);
+    EXPECT_EQ(Validator::validate("\"top\""), Rt2::Npos);
+    EXPECT_EQ(Validator::validate("0"), Rt2::Npos);
+    EXPECT_EQ(Validator::validate("\"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\""), Rt2::Npos);
+
+    EXPECT_EQ(Validator::validate(""), 0);
+    EXPECT_EQ(Validator::validate("[1,2"), 4);
+    EXPECT_EQ(Validator::validate("[1,]"), 3);
+    EXPECT_EQ(Validator::validate("[1 2]"), 3);
+    EXPECT_EQ(Validator::validate("{\"a\" 1}"), 5);
+    EXPECT_EQ(Validator::validate("{\"a\":01}"), 5);
+    EXPECT_EQ(Validator::validate("[tru]"), 1);
+    EXPECT_EQ(Validator::validate("[\"a\\x\"]"), 4);
+    EXPECT_EQ(Validator::validate("[\"a\tb\"]"), 3);
+    EXPECT_EQ(Validator::validate("{} {}"), 3);
+    EXPECT_EQ(Validator::validate("// comment\n{}"), 0);
+
+    // overlong, surrogate, truncated and out of range sequences
+    EXPECT_EQ(Validator::validate("\"ab\xC0\xAF\""), 3);
+    EXPECT_EQ(Validator::validate("\"\xED\xA0\x80\""), 1);
+    EXPECT_EQ(Validator::validate("\"\xE2\x82\""), 1);
+    EXPECT_EQ(Validator::validate("\"\xF4\x90\x80\x80\""), 1);
+    EXPECT_EQ(Validator::validate("\"abcdefghijkl\xFF\""), 13);
+}
+
+GTEST_TEST(Validator, Validate_002)
+{
+    const Rt2::String deep = Rt2::String(Validator::MaxDepth, '[') + Rt2::String(Validator::MaxDepth, ']');
+    EXPECT_EQ(Validator::validate(deep), Rt2::Npos);
+
+    const Rt2::String deeper = "[" + deep + "]";
+    EXPECT_EQ(Validator::validate(deeper), Validator::MaxDepth);
+
+    Rt2::String mixed;
+    for (Rt2::U32 i = 0; i < 100; ++i)
+        mixed += i % 2 ? "{\"k\":" : "[";
+    mixed += "1";
+    for (Rt2::U32 i = 100; i > 0; --i)
+        mixed += (i - 1) % 2 ? "}" : "]";
+    EXPECT_EQ(Validator::validate(mixed), Rt2::Npos);
+}
+
+GTEST_TEST(Scanner, Skip_001)
+{
+    const Rt2::String src = R"([{"a":"]}\"[",// note ]
+"b":[[1,2],{"c":"\\"}]}],true)";
+
+    Scanner scn;
+    scn.borrow(src.c_str(), src.size());
+
+    Token tok;
+    scn.scan(tok);
+    EXPECT_EQ(tok.type(), JT_L_BRACE);
+    scn.scan(tok);
+    EXPECT_EQ(tok.type(), JT_L_BRACKET);
+    EXPECT_TRUE(scn.skip(tok));
+    scn.scan(tok);
+    EXPECT_EQ(tok.type(), JT_R_BRACE);
+    scn.scan(tok);
+    EXPECT_EQ(tok.type(), JT_COMMA);
+    scn.scan(tok);
+    EXPECT_EQ(tok.type(), JT_BOOL);
+
+    const Rt2::String open = R"([{"a":[1,2})";
+    scn.borrow(open.c_str(), open.size());
+    scn.scan(tok);
+    EXPECT_FALSE(scn.skip(tok));
+}
+
+GTEST_TEST(Projection, Parse_001)
+{
+    // large enough to be scanned with the structural index
+    Rt2::String src = R"({"meta":{"id":7,"tags":["a","b"]},"skip":[)";
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i)
+            src.push_back(',');
+        src += R"({"x":"]}\"{","y":[[1],[2,{"z":null}]]})";
+    }
+    src += R"(],"items":[{"id":1},{"id":2,"name":"two"}],"a/b":{"m~n":1.5}})";
+
+    Projection proj;
+    const size_t id    = proj.add("/meta/id");
+    const size_t tags  = proj.add("/meta/tags");
+    const size_t tag1  = proj.add("/meta/tags/1");
+    const size_t name  = proj.add("/items/1/name");
+    const size_t esc   = proj.add("/a~1b/m~0n");
+    const size_t none  = proj.add("/items/5/id");
+    const size_t again = proj.add("/meta/id");
+    EXPECT_EQ(id, again);
+    EXPECT_EQ(proj.add("meta"), Rt2::Npos);
+    EXPECT_EQ(proj.add("/bad~2"), Rt2::Npos);
+
+    ASSERT_TRUE(proj.parse(src.c_str(), src.size()));
+    ASSERT_NE(proj.at(id), nullptr);
+    EXPECT_EQ(proj.at(id)->i64(), 7);
+    ASSERT_NE(proj.at(tags), nullptr);
+    EXPECT_TRUE(proj.at(tags)->Type::toString() == R"(["a","b"])");
+    EXPECT_EQ(proj.at(tag1), proj.at(tags)->asArray()->at(1));
+    ASSERT_NE(proj.at(name), nullptr);
+    EXPECT_TRUE(proj.at(name)->string() == "two");
+    ASSERT_NE(proj.at(esc), nullptr);
+    EXPECT_DOUBLE_EQ(proj.at(esc)->r64(), 1.5);
+    EXPECT_EQ(proj.at(none), nullptr);
+}
+
+GTEST_TEST(Projection, Parse_002)
+{
+    const Rt2::String src = R"([{"k":1},{"k":2,"k":3}])";
+
+    Projection proj;
+    const size_t root = proj.add("");
+    const size_t k    = proj.add("/1/k");
+    ASSERT_TRUE(proj.parse(src.c_str(), src.size()));
+    EXPECT_TRUE(proj.at(root)->Type::toString() == R"([{"k":1},{"k":2}])");
+    EXPECT_EQ(proj.at(k)->i64(), 2);
+
+    Projection first;
+    const size_t value = first.add("/0/k");
+    const Rt2::String bad = R"([{"k":5}, oops)";
+    EXPECT_TRUE(first.parse(bad.c_str(), bad.size()));
+    EXPECT_EQ(first.at(value)->i64(), 5);
+
+    Projection missing;
+    const size_t obj = missing.add("/0");
+    const size_t x   = missing.add("/0/x");
+    const size_t y   = missing.add("/0/k/y");
+    EXPECT_TRUE(missing.parse(bad.c_str(), bad.size()));
+    EXPECT_TRUE(missing.at(obj)->Type::toString() == R"({"k":5})");
+    EXPECT_EQ(missing.at(x), nullptr);
+    EXPECT_EQ(missing.at(y), nullptr);
+
+    const Rt2::String broken = R"([{"j" 5}])";
+    EXPECT_FALSE(first.parse(broken.c_str(), broken.size()));
+    EXPECT_EQ(first.at(value), nullptr);
+}
+
+static Rt2::String RandomValue(std::mt19937& rng, const int depth)
+{
+    static const char* Strings[] = {R"("a")", R"("}]")", R"("\"[{")", R"("\\")", R"("x\\\"y")", R"("")"};
+
+    switch (depth > 0 ? rng() % 4 : 3)
+    {
+    case 0:
+    {
+        Rt2::String arr = "[";
+        for (Rt2::U32 i = 0, n = rng() % 5; i < n; ++i)
+            arr += (i ? "," : "") + RandomValue(rng, depth - 1);
+        return arr + "]";
+    }
+    case 1:
+    {
+        Rt2::String obj = "{";
+        for (Rt2::U32 i = 0, n = rng() % 5; i < n; ++i)
+            obj += (i ? "," : "") + Rt2::String(Strings[rng() % 6]) + ":" + RandomValue(rng, depth - 1);
+        return obj + "}";
+    }
+    case 2:
+        return Strings[rng() % 6];
+    default:
+        return std::to_string(rng() % 1000);
+    }
+}
+
+GTEST_TEST(Scanner, Skip_002)
+{
+    std::mt19937 rng(21);
+    for (int i = 0; i < 500; ++i)
+    {
+        const Rt2::String src = "[" + RandomValue(rng, 6) + ",true]";
+        for (const size_t threshold : {Rt2::Npos, (size_t)0})
+        {
+            Scanner scn;
+            scn.setIndexThreshold(threshold);
+            scn.borrow(src.c_str(), src.size());
+
+            Token tok;
+            scn.scan(tok);
+            scn.scan(tok);
+            ASSERT_TRUE(scn.skip(tok)) << src;
+            scn.scan(tok);
+            ASSERT_EQ(tok.type(), JT_COMMA) << src;
+            scn.scan(tok);
+            ASSERT_EQ(tok.type(), JT_BOOL) << src;
+        }
+    }
+}
+
+class RouterVisitor final : public Visitor
+{
+public:
+    Rt2::String header;
+    int         values{0};
+    bool        stop{false};
+
+    VisitAction keyParsed(const StringView& key) override
+    {
+        if (key == "header")
+            return VA_CONTINUE;
+        return stop ? VA_STOP : VA_SKIP;
+    }
+
+    void keyValueParsed(const StringView& key, const TokenType& valueType, const StringView& value) override
+    {
+        ++values;
+        if (key == "header")
+            header.assign(value.data(), value.size());
+    }
+
+    void objectCreated() override
+    {
+        ++values;
+    }
+};
+
+GTEST_TEST(Parser, KeyParsed_001)
+{
+    Rt2::String body = "[";
+    for (int i = 0; i < 200; ++i)
+        body += i ? R"(,{"s":"]}\"{[","n":[1,[2,{}]]})" : R"({"s":"]}\"{[","n":[1,[2,{}]]})";
+    body += "]";
+
+    const Rt2::String src = R"({"body":)" + body + R"(,"header":"route-7","tail":{"a":1}})";
+
+    RouterVisitor router;
+    Parser        parser(&router);
+    parser.parse(src.c_str(), src.size());
+    EXPECT_TRUE(router.header == "route-7");
+    // the root object and the header, nothing from the skipped members
+    EXPECT_EQ(router.values, 2);
+
+    RouterVisitor stopping;
+    stopping.stop = true;
+    Parser stopped(&stopping);
+    EXPECT_EQ(stopped.parse(src.c_str(), src.size()), nullptr);
+    EXPECT_TRUE(stopping.header.empty());
+
+    Parser      tree;
+    const Type* root = tree.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+}
+
+GTEST_TEST(StreamParser, KeyParsed_001)
+{
+    // the skipped body holds brackets inside of a string and a comment
+    const Rt2::String src = R"({"body":[{"s":"]}\"{[","n":[1,[2,{}]]}, // ]})"
+                            "\n"
+                            R"({"x":1}],"skip":true,"header":"route-7","tail":{"a":1}})";
+
+    for (size_t chunk = 1; chunk < 12; ++chunk)
+    {
+        RouterVisitor router;
+        StreamParser  stream(&router);
+        for (size_t i = 0; i < src.size(); i += chunk)
+            EXPECT_TRUE(stream.feed(src.c_str() + i, std::min(chunk, src.size() - i)));
+        EXPECT_TRUE(stream.done());
+        EXPECT_TRUE(router.header == "route-7");
+        EXPECT_EQ(router.values, 2);
+
+        RouterVisitor stopping;
+        stopping.stop = true;
+        StreamParser stopped(&stopping);
+        for (size_t i = 0; i < src.size() && !stopped.stopped(); i += chunk)
+            stopped.feed(src.c_str() + i, std::min(chunk, src.size() - i));
+        EXPECT_TRUE(stopped.stopped());
+        EXPECT_FALSE(stopped.failed());
+        EXPECT_EQ(stopped.finish(), nullptr);
+        EXPECT_EQ(stopping.values, 1);
+    }
+}
+
+GTEST_TEST(Lazy, Parse_001)
+{
+    const Rt2::String src = R"({
+        "version": 3,
+        "skipped": {"deep": [1, {"x": "]}"}, [2]]},
+        "items": [
+            {"id": 1, "price": 2.5, "tags": ["a", "b"], "ok": true},
+            {"price": 4.0, "id": 2, "name": "w\"x", "ok": false},
+            {"id": 3, "price": 0.5, "extra": [[[]]], "ok": null}
+        ],
+        "footer": "end"
+    })";
+
+    LazyDocument doc;
+    LazyValue    root = doc.parse(src.c_str(), src.size());
+    EXPECT_EQ(root.type(), Type::OBJECT);
+    EXPECT_EQ(root["version"].i64(), 3);
+
+    double     total = 0;
+    Rt2::I64   ids   = 0;
+    int        count = 0;
+    for (LazyValue item : root["items"].array())
+    {
+        // fields are read in whichever order they appear
+        for (const auto& member : item.object())
+        {
+            if (member.first == "price")
+                total += member.second.r64();
+            else if (member.first == "id")
+                ids += member.second.i64();
+            else if (member.first == "name")
+            {
+                EXPECT_TRUE(member.second.string() == "w\"x");
+            }
+        }
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+    EXPECT_DOUBLE_EQ(total, 7.0);
+    EXPECT_EQ(ids, 6);
+
+    LazyValue footer = root["footer"];
+    EXPECT_TRUE(footer.string() == "end");
+    EXPECT_FALSE(doc.failed());
+
+    // forward only, the earlier key has been passed
+    EXPECT_FALSE(root["version"].valid());
+}
+
+GTEST_TEST(Lazy, Parse_002)
+{
+    const Rt2::String src = R"([[1,2,3],{"a":{"b":[4,5]}},6,"s",true,null])";
+
+    LazyDocument doc;
+    LazyArray    arr = doc.parse(src.c_str(), src.size()).array();
+    ASSERT_TRUE(arr.valid());
+
+    LazyValue value;
+    ASSERT_TRUE(arr.next(value));
+    LazyArray inner = value.array();
+    ASSERT_TRUE(inner.next(value));
+    EXPECT_EQ(value.i64(), 1);
+
+    // leave the inner array half read
+    ASSERT_TRUE(arr.next(value));
+    EXPECT_FALSE(inner.valid());
+    EXPECT_EQ(value["a"]["b"].type(), Type::ARRAY);
+
+    ASSERT_TRUE(arr.next(value));
+    EXPECT_EQ(value.i32(), 6);
+    LazyValue stale = value;
+    ASSERT_TRUE(arr.next(value));
+    EXPECT_FALSE(stale.valid());
+    EXPECT_EQ(stale.i64(9), 9);
+    EXPECT_TRUE(value.string() == "s");
+    ASSERT_TRUE(arr.next(value));
+    EXPECT_TRUE(value.boolean());
+    ASSERT_TRUE(arr.next(value));
+    EXPECT_TRUE(value.isNull());
+    EXPECT_FALSE(arr.next(value));
+    EXPECT_FALSE(arr.valid());
+    EXPECT_FALSE(doc.failed());
+
+    const Rt2::String bad = R"([1 2])";
+    LazyArray broken = doc.parse(bad.c_str(), bad.size()).array();
+    EXPECT_TRUE(broken.next(value));
+    EXPECT_FALSE(broken.next(value));
+    EXPECT_TRUE(doc.failed());
+}
+
+GTEST_TEST(Lazy, Unsigned_001)
+{
+    const Rt2::String src = R"([18446744073709551615,9223372036854775808,42,-1,-9223372036854775809,18446744073709551616,1.5])";
+
+    LazyDocument doc;
+    LazyArray    arr = doc.parse(src.c_str(), src.size()).array();
+
+    const Rt2::U64 expected[] = {UINT64_MAX, 9223372036854775808u, 42, 7, 7, 7, 7};
+
+    LazyValue value;
+    for (const Rt2::U64 u64 : expected)
+    {
+        ASSERT_TRUE(arr.next(value));
+        EXPECT_EQ(value.u64(7), u64);
+    }
+    EXPECT_FALSE(arr.next(value));
+    EXPECT_FALSE(doc.failed());
+}
+
+class RecordCollector final : public NdJsonReader::Listener
+{
+public:
+    Rt2::Array<size_t>   lines;
+    Rt2::Array<Rt2::I64> ids;
+    size_t               stopAfter{Rt2::Npos};
+
+    bool recordParsed(const size_t line, Type* root) override
+    {
+        lines.push_back(line);
+        ids.push_back(root && root->isObject() ? root->asObject()->i64("id", -1) : -1);
+        return lines.size() < stopAfter;
+    }
+};
+
+GTEST_TEST(NdJson, Read_001)
+{
+    const Rt2::String src = "{\"id\":0}\n"
+                            "\n"
+                            "  [1,2]\r\n"
+                            "{\"id\":3, \"s\":\"a\\nb\"}\n"
+                            "{\"id\":4} x\n"
+                            "{\"id\":5\n"
+                            "{\"id\":6}";
+
+    NdJsonReader    reader;
+    RecordCollector collector;
+    EXPECT_TRUE(reader.read(src.c_str(), src.size(), collector));
+
+    ASSERT_EQ(collector.lines.size(), 6u);
+    const size_t   lines[] = {0, 2, 3, 4, 5, 6};
+    const Rt2::I64 ids[]   = {0, -1, 3, -1, -1, 6};
+    for (size_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(collector.lines[i], lines[i]);
+        EXPECT_EQ(collector.ids[i], ids[i]);
+    }
+}
+
+GTEST_TEST(NdJson, Read_002)
+{
+    Rt2::String src;
+    for (int i = 0; i < 5000; ++i)
+    {
+        src += "{\"id\":" + std::to_string(i) + ",\"tags\":[\"a\",\"b\"],\"v\":{\"x\":1.5}}\n";
+        if (i % 7 == 0)
+            src += "\n";
+    }
+
+    NdJsonReader reader;
+    reader.setBatchSize(64);
+
+    RecordCollector collector;
+    EXPECT_TRUE(reader.read(src.c_str(), src.size(), collector));
+    ASSERT_EQ(collector.ids.size(), 5000u);
+    for (size_t i = 0; i < 5000; ++i)
+        EXPECT_EQ(collector.ids[i], (Rt2::I64)i);
+
+    RecordCollector stopped;
+    stopped.stopAfter = 100;
+    EXPECT_FALSE(reader.read(src.c_str(), src.size(), stopped));
+    EXPECT_EQ(stopped.ids.size(), 100u);
+    EXPECT_EQ(stopped.ids.back(), 99);
+}
+
+GTEST_TEST(ParallelParser, Parse_001)
+{
+    std::mt19937 rng(24);
+
+    Rt2::String src = "[";
+    for (int i = 0; i < 2000; ++i)
+        src += (i ? ", " : " ") + RandomValue(rng, 4);
+    src += "]\n";
+
+    Document expected;
+    ASSERT_NE(expected.parse(src.c_str(), src.size()), nullptr);
+
+    // small chunks put seams inside of strings, escapes and elements
+    for (const size_t chunk : {64, 192, 4096})
+    {
+        ParallelParser parser;
+        parser.setChunkSize(chunk);
+        parser.setThreadCount(4);
+
+        Type* root = parser.parse(src.c_str(), src.size());
+        ASSERT_NE(root, nullptr);
+        ASSERT_TRUE(root->isArray());
+        EXPECT_EQ(root->asArray()->size(), 2000u);
+        EXPECT_TRUE(root->Type::toString() == expected.root()->Type::toString());
+    }
+}
+
+GTEST_TEST(ParallelParser, Parse_002)
+{
+    ParallelParser parser;
+    parser.setChunkSize(64);
+    parser.setThreadCount(4);
+
+    Rt2::String items;
+    for (int i = 0; i < 200; ++i)
+        items += std::to_string(i) + ",";
+
+    // a trailing comma is accepted like the serial parser does
+    Rt2::String src = "[" + items + "]";
+    Type*       root = parser.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(root->asArray()->size(), 200u);
+    EXPECT_EQ(root->asArray()->i64(199), 199);
+
+    src = "[" + items + ",1]";
+    EXPECT_EQ(parser.parse(src.c_str(), src.size()), nullptr);
+
+    src = "[" + items + "1}]";
+    EXPECT_EQ(parser.parse(src.c_str(), src.size()), nullptr);
+
+    src = "[" + items + "\"1]";
+    EXPECT_EQ(parser.parse(src.c_str(), src.size()), nullptr);
+
+    // comments and other roots fall back to a serial parse
+    src = "[" + items + "// end\n 1]";
+    root = parser.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(root->asArray()->size(), 201u);
+
+    src = "{\"a\":[" + items + "1]}";
+    root = parser.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->isObject());
+}
+
+GTEST_TEST(Document, Freeze_001)
+{
+    const Rt2::String src = R"({"name":"cfg","port":8080,"ratio":0.25,"on":true,)"
+                            R"("hosts":[{"id":1},{"id":2},{"id":3}]})";
+
+    Document doc;
+    doc.setLazyNumbers(true);
+    ASSERT_NE(doc.parse(src.c_str(), src.size()), nullptr);
+
+    const Type* root = doc.freeze();
+    ASSERT_NE(root, nullptr);
+    EXPECT_TRUE(root->isFrozen());
+
+    const ObjectType* obj   = root->asObject();
+    const ArrayType*  hosts = obj->find("hosts")->asArray();
+    ASSERT_NE(hosts, nullptr);
+    EXPECT_TRUE(hosts->at(2)->isFrozen());
+    EXPECT_EQ(hosts->at(3), nullptr);
+
+    // every reader sees the same values from const accessors
+    std::atomic<int> mismatches{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t)
+    {
+        readers.emplace_back([&]
+                             {
+                                 for (int i = 0; i < 1000; ++i)
+                                 {
+                                     if (obj->i64(Key("port")) != 8080 ||
+                                         obj->r64("ratio") != 0.25 ||
+                                         !obj->boolean("on") ||
+                                         obj->string(Key("name")) != "cfg" ||
+                                         obj->find(Key("port"))->string() != "8080" ||
+                                         hosts->at(1)->asObject()->i32("id") != 2)
+                                         ++mismatches;
+                                 }
+                             });
+    }
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+GTEST_TEST(Document, Freeze_002)
+{
+    const Rt2::String src = R"({"list":[1,2],"n":3})";
+
+    Document doc;
+    doc.setLazyNumbers(true);
+    Type* root = doc.parse(src.c_str(), src.size());
+    ASSERT_NE(root, nullptr);
+    doc.freeze();
+
+    // a change clears the flag of the node that changed
+    ObjectType* obj  = root->asObject();
+    ArrayType*  list = obj->find("list")->asArray();
+
+    IntegerType* added = doc.create<IntegerType>();
+    added->setRaw(StringView("40"));
+    list->add(added);
+    EXPECT_FALSE(list->isFrozen());
+    EXPECT_FALSE(added->isFrozen());
+
+    obj->find("n")->setRaw(StringView("5"));
+    EXPECT_FALSE(obj->find("n")->isFrozen());
+
+    obj->insert("m", (Rt2::I64)6);
+    EXPECT_FALSE(obj->isFrozen());
+
+    // freezing again reaches the new and changed nodes below frozen parents
+    const Type* frozen = doc.freeze();
+    EXPECT_TRUE(frozen->isFrozen());
+    EXPECT_TRUE(list->isFrozen());
+    EXPECT_TRUE(added->isFrozen());
+    EXPECT_TRUE(obj->find("n")->isFrozen());
+    EXPECT_EQ(frozen->asObject()->find("list")->asArray()->i64(2), 40);
+    EXPECT_EQ(frozen->asObject()->i64("n"), 5);
+    EXPECT_EQ(frozen->asObject()->i64("m"), 6);
+}